@@ -0,0 +1,255 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef MOZI_ATOMIC_BIT_FIELDS_HPP
+#define MOZI_ATOMIC_BIT_FIELDS_HPP
+
+// Atomic bit-fields containers keep all the fields in one std::atomic
+// word, so that threads can read and update them without a lock.  Single
+// fields are read and written through atomic_bit_field_ref proxies, and
+// several fields can be changed together by update, which applies a
+// function to a packed copy of the word in a compare-and-swap loop.
+
+#include <atomic>              // std::atomic/memory_order
+#include <climits>             // CHAR_BIT
+#include <cstddef>             // std::size_t
+#include <cstdint>             // std::uint64_t
+#include <type_traits>         // std::is_integral/remove_const
+#include <utility>             // std::declval
+#include "bit_fields_core.hpp" // mozi::bit_field_ref/...
+
+namespace mozi {
+
+// Proxy to a bit field kept at a bit offset in an atomic word.  Atomic
+// shall be std::atomic<Storage> or its const version.  Stores to a field
+// are done with a compare-and-swap loop on the whole word, except that a
+// one-bit field is set or cleared with a single fetch_or or fetch_and.
+template <typename Atomic, unsigned Offset, typename BitField>
+class atomic_bit_field_ref {
+public:
+    using storage_type =
+        typename std::remove_const_t<Atomic>::value_type;
+    using value_type = typename BitField::value_type;
+    using interface_type = typename BitField::interface_type;
+    static constexpr std::size_t length = BitField::length;
+    static constexpr auto signedness = BitField::signedness;
+    static_assert(std::is_integral_v<storage_type>);
+    static_assert(Offset + length <= sizeof(storage_type) * CHAR_BIT);
+
+    explicit atomic_bit_field_ref(Atomic& bits) noexcept : bits_(bits) {}
+    atomic_bit_field_ref(const atomic_bit_field_ref&) = default;
+
+    interface_type
+    load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return get(bits_.load(order));
+    }
+    operator interface_type() const noexcept
+    {
+        return load();
+    }
+
+    void store(BitField value,
+               std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        (void)exchange(value, order);
+    }
+    atomic_bit_field_ref& operator=(BitField value) noexcept
+    {
+        store(value);
+        return *this;
+    }
+
+    interface_type
+    exchange(BitField value,
+             std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        if constexpr (length == 1) {
+            constexpr auto mask =
+                static_cast<storage_type>(std::uint64_t{1} << Offset);
+            if (value.underlying_value() != 0) {
+                return get(bits_.fetch_or(mask, order));
+            } else {
+                return get(bits_.fetch_and(
+                    static_cast<storage_type>(~mask), order));
+            }
+        } else {
+            storage_type old_bits = bits_.load(std::memory_order_relaxed);
+            storage_type new_bits;
+            do {
+                new_bits = old_bits;
+                detail::set_storage_bits<Offset, length>(
+                    new_bits, value.underlying_value());
+            } while (!bits_.compare_exchange_weak(
+                old_bits, new_bits, order, std::memory_order_relaxed));
+            return get(old_bits);
+        }
+    }
+
+    // Replaces the field with desired if it equals expected, leaving the
+    // other fields alone.  Changes to the other fields do not cause
+    // failures: false is returned only when the field itself differs from
+    // expected, which then receives the current value of the field.
+    bool compare_exchange_strong(
+        interface_type& expected, BitField desired,
+        std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        const auto expected_value = BitField(expected).underlying_value();
+        storage_type old_bits = bits_.load(std::memory_order_relaxed);
+        storage_type new_bits;
+        do {
+            if (detail::get_storage_bits<Offset, length>(old_bits) !=
+                expected_value) {
+                expected = get(old_bits);
+                return false;
+            }
+            new_bits = old_bits;
+            detail::set_storage_bits<Offset, length>(
+                new_bits, desired.underlying_value());
+        } while (!bits_.compare_exchange_weak(old_bits, new_bits, order,
+                                              std::memory_order_relaxed));
+        return true;
+    }
+
+private:
+    static interface_type get(storage_type bits) noexcept
+    {
+        return bit_field_ref<const storage_type, Offset, BitField>(bits);
+    }
+
+    Atomic& bits_;
+};
+
+namespace detail {
+
+template <typename T, std::size_t I, typename Atomic>
+auto make_atomic_bit_field_ref(Atomic& bits) noexcept
+{
+    using field_type = typename T::template _field<T&, I>::type;
+    return atomic_bit_field_ref<Atomic, get_bit_field_offset<T, I>(),
+                                field_type>(bits);
+}
+
+} // namespace detail
+
+} // namespace mozi
+
+#define MOZI_ATOMIC_BIT_FIELD(i, arg)                                      \
+    auto MOZI_STRIP(arg)() noexcept                                        \
+    {                                                                      \
+        return mozi::detail::make_atomic_bit_field_ref<unpacked_type, i>(  \
+            _bits);                                                        \
+    }                                                                      \
+    auto MOZI_STRIP(arg)() const noexcept                                  \
+    {                                                                      \
+        return mozi::detail::make_atomic_bit_field_ref<unpacked_type, i>(  \
+            _bits);                                                        \
+    }
+
+// Defines a bit-fields container that keeps all the fields, at most 64
+// bits in total, in one std::atomic word.  Whole values are loaded and
+// stored as packed_type, the equivalent container defined by
+// MOZI_DEFINE_PACKED_BIT_FIELDS_CONTAINER.  update(f) calls f on a
+// packed_type reference until the result can be stored by a single
+// compare-and-swap, and returns the value before the update; f may be
+// called several times under contention, so it should have no side
+// effects.
+#define MOZI_DEFINE_ATOMIC_BIT_FIELDS_CONTAINER(st, ...)                   \
+    struct st {                                                            \
+        MOZI_DEFINE_PACKED_BIT_FIELDS_CONTAINER(packed_type, __VA_ARGS__); \
+        using unpacked_type = packed_type::unpacked_type;                  \
+        using storage_type = packed_type::storage_type;                    \
+        static_assert(std::is_integral_v<storage_type>,                    \
+                      "Atomic bit fields shall fit in 64 bits");           \
+        static constexpr bool is_always_lock_free =                        \
+            std::atomic<storage_type>::is_always_lock_free;                \
+        std::atomic<storage_type> _bits{};                                 \
+        st() = default;                                                    \
+        constexpr explicit st(packed_type value) noexcept                  \
+            : _bits(value._bits)                                           \
+        {                                                                  \
+        }                                                                  \
+        constexpr explicit st(const unpacked_type& obj) noexcept           \
+            : _bits(mozi::pack_bit_fields(obj))                            \
+        {                                                                  \
+        }                                                                  \
+        packed_type                                                        \
+        load(std::memory_order order = std::memory_order_seq_cst)          \
+            const noexcept                                                 \
+        {                                                                  \
+            return packed_type{_bits.load(order)};                         \
+        }                                                                  \
+        void store(packed_type value, std::memory_order order =            \
+                                          std::memory_order_seq_cst)       \
+            noexcept                                                       \
+        {                                                                  \
+            _bits.store(value._bits, order);                               \
+        }                                                                  \
+        packed_type exchange(packed_type value,                            \
+                             std::memory_order order =                     \
+                                 std::memory_order_seq_cst) noexcept       \
+        {                                                                  \
+            return packed_type{_bits.exchange(value._bits, order)};        \
+        }                                                                  \
+        bool compare_exchange_weak(packed_type& expected,                  \
+                                   packed_type desired,                    \
+                                   std::memory_order order =               \
+                                       std::memory_order_seq_cst) noexcept \
+        {                                                                  \
+            return _bits.compare_exchange_weak(expected._bits,             \
+                                               desired._bits, order);      \
+        }                                                                  \
+        bool compare_exchange_strong(packed_type& expected,                \
+                                     packed_type desired,                  \
+                                     std::memory_order order =             \
+                                         std::memory_order_seq_cst)        \
+            noexcept                                                       \
+        {                                                                  \
+            return _bits.compare_exchange_strong(expected._bits,           \
+                                                 desired._bits, order);    \
+        }                                                                  \
+        template <typename F>                                              \
+        packed_type                                                        \
+        update(F f,                                                        \
+               std::memory_order order = std::memory_order_seq_cst)        \
+            noexcept(noexcept(f(std::declval<packed_type&>())))            \
+        {                                                                  \
+            packed_type old_value{_bits.load(std::memory_order_relaxed)};  \
+            packed_type new_value;                                         \
+            do {                                                           \
+                new_value = old_value;                                     \
+                f(new_value);                                              \
+            } while (!_bits.compare_exchange_weak(                         \
+                old_value._bits, new_value._bits, order,                   \
+                std::memory_order_relaxed));                               \
+            return old_value;                                              \
+        }                                                                  \
+        MOZI_REPEAT_ON(MOZI_ATOMIC_BIT_FIELD, __VA_ARGS__)                 \
+    }
+
+#if !defined(DEFINE_ATOMIC_BIT_FIELDS_CONTAINER) &&                        \
+    !defined(MOZI_NO_DEFINE_ATOMIC_BIT_FIELDS_CONTAINER)
+#define DEFINE_ATOMIC_BIT_FIELDS_CONTAINER                                 \
+    MOZI_DEFINE_ATOMIC_BIT_FIELDS_CONTAINER
+#endif
+
+#endif // MOZI_ATOMIC_BIT_FIELDS_HPP
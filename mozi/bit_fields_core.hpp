@@ -24,11 +24,13 @@
 #ifndef MOZI_BIT_FIELDS_CORE_HPP
 #define MOZI_BIT_FIELDS_CORE_HPP
 
+#include <array>                      // std::array
+#include <climits>                    // CHAR_BIT
 #include <cstddef>                    // std::size_t
 #include <cstdint>                    // std::uint8_t/uint16_t/uint32_t/...
-#include <type_traits>                // std::enable_if
+#include <type_traits>                // std::enable_if/is_integral/...
 #include "metamacro.h"                // MOZI_GET_ARG_COUNT/MOZI_REPEAT_ON
-#include "struct_reflection_core.hpp" // mozi::for_each_meta/MOZI_FIELD
+#include "struct_reflection_core.hpp" // mozi::for_each/MOZI_FIELD/...
 #include "type_traits.hpp"            // mozi::is_bit_fields_container/...
 
 namespace mozi {
@@ -53,13 +55,78 @@ struct bits_storage<N, std::enable_if_t<(N > 16 && N <= 32)>> {
     using type = std::uint32_t;
 };
 
-constexpr std::uint32_t get_bit_field_mask(unsigned len)
+template <std::size_t N>
+struct bits_storage<N, std::enable_if_t<(N > 32 && N <= 64)>> {
+    using type = std::uint64_t;
+};
+
+// Storage of N bits packed together: an unsigned integer when they fit in
+// 64 bits, or otherwise an array of 64-bit words, the least significant
+// word first
+template <std::size_t N, typename = void>
+struct bit_fields_storage {
+    using type = std::array<std::uint64_t, (N + 63) / 64>;
+};
+
+template <std::size_t N>
+struct bit_fields_storage<N, std::enable_if_t<(N <= 64)>> {
+    using type = typename bits_storage<N>::type;
+};
+
+// T shall be std::uint32_t or std::uint64_t
+template <typename T = std::uint32_t>
+constexpr T get_bit_field_mask(unsigned len)
 {
     // Shift count overflow is undefined behavior
-    if (len >= 32) {
-        return UINT32_MAX;
+    if (len >= sizeof(T) * CHAR_BIT) {
+        return ~T{};
+    }
+    return ~(~T{} << len);
+}
+
+// Gets Len bits at an offset from the least significant bit of the bit
+// storage.  With the offset and length known at compile time, this is a
+// fixed shift and mask, or two of them when the bits span two words.
+template <unsigned Offset, unsigned Len, typename Storage>
+constexpr std::uint64_t get_storage_bits(const Storage& bits)
+{
+    constexpr auto mask = get_bit_field_mask<std::uint64_t>(Len);
+    if constexpr (std::is_integral_v<Storage>) {
+        return (std::uint64_t{bits} >> Offset) & mask;
+    } else {
+        constexpr unsigned index = Offset / 64;
+        constexpr unsigned shift = Offset % 64;
+        if constexpr (shift + Len <= 64) {
+            return (bits[index] >> shift) & mask;
+        } else {
+            return ((bits[index] >> shift) |
+                    (bits[index + 1] << (64 - shift))) &
+                   mask;
+        }
+    }
+}
+
+// Sets Len bits at an offset from the least significant bit of the bit
+// storage
+template <unsigned Offset, unsigned Len, typename Storage>
+constexpr void set_storage_bits(Storage& bits, std::uint64_t value)
+{
+    constexpr auto mask = get_bit_field_mask<std::uint64_t>(Len);
+    value &= mask;
+    if constexpr (std::is_integral_v<Storage>) {
+        bits = static_cast<Storage>((bits & ~(mask << Offset)) |
+                                    (value << Offset));
+    } else {
+        constexpr unsigned index = Offset / 64;
+        constexpr unsigned shift = Offset % 64;
+        bits[index] = (bits[index] & ~(mask << shift)) | (value << shift);
+        if constexpr (shift + Len > 64) {
+            constexpr auto high_mask =
+                get_bit_field_mask<std::uint64_t>(shift + Len - 64);
+            bits[index + 1] =
+                (bits[index + 1] & ~high_mask) | (value >> (64 - shift));
+        }
     }
-    return ~(UINT32_MAX << len);
 }
 
 } // namespace detail
@@ -76,6 +143,14 @@ public:
     static_assert(sizeof(unsigned) >= sizeof(std::uint32_t));
 
     using value_type = typename detail::bits_storage<N>::type;
+    // Types of the values the bit field converts from and to:
+    // unsigned/int up to 32 bits, and 64-bit integers otherwise
+    using unsigned_type =
+        std::conditional_t<(N <= 32), unsigned, std::uint64_t>;
+    using signed_type = std::make_signed_t<unsigned_type>;
+    using interface_type =
+        std::conditional_t<Signedness == bit_field_unsigned, unsigned_type,
+                           signed_type>;
     static constexpr std::size_t length = N;
     static constexpr auto signedness = Signedness;
 
@@ -83,38 +158,39 @@ public:
 
     template <bit_field_signedness S = Signedness,
               std::enable_if_t<S == bit_field_unsigned, int> = 0>
-    constexpr bit_field(unsigned value)
+    constexpr bit_field(unsigned_type value)
     {
         *this = value;
     }
     template <bit_field_signedness S = Signedness,
               std::enable_if_t<S == bit_field_signed, int> = 0>
-    constexpr bit_field(int value)
+    constexpr bit_field(signed_type value)
     {
         *this = value;
     }
 
     template <bit_field_signedness S = Signedness,
               std::enable_if_t<S == bit_field_unsigned, int> = 0>
-    constexpr bit_field& operator=(unsigned value)
+    constexpr bit_field& operator=(unsigned_type value)
     {
         // Truncated
-        value_ = value & detail::get_bit_field_mask(N);
+        value_ = value & detail::get_bit_field_mask<unsigned_type>(N);
         return *this;
     }
     template <bit_field_signedness S = Signedness,
               std::enable_if_t<S == bit_field_signed, int> = 0>
-    constexpr bit_field& operator=(int value)
+    constexpr bit_field& operator=(signed_type value)
     {
         // Truncated and sign-extended, assuming two's-complement
         // representation
-        constexpr unsigned sign_bit = 1U << (N - 1);
-        if (value >= 0 && (static_cast<unsigned>(value) & sign_bit) == 0) {
+        constexpr unsigned_type sign_bit = unsigned_type{1} << (N - 1);
+        if (value >= 0 &&
+            (static_cast<unsigned_type>(value) & sign_bit) == 0) {
             value_ = static_cast<value_type>(value) &
-                     detail::get_bit_field_mask(N);
+                     detail::get_bit_field_mask<unsigned_type>(N);
         } else {
             value_ = static_cast<value_type>(value) |
-                     ~detail::get_bit_field_mask(N - 1);
+                     ~detail::get_bit_field_mask<unsigned_type>(N - 1);
         }
         return *this;
     }
@@ -124,21 +200,17 @@ public:
         if constexpr (Signedness == bit_field_unsigned) {
             return value_;
         } else {
-            return value_ & detail::get_bit_field_mask(N);
+            return value_ & detail::get_bit_field_mask<unsigned_type>(N);
         }
     }
 
-    template <bit_field_signedness S = Signedness,
-              std::enable_if_t<S == bit_field_unsigned, int> = 0>
-    constexpr operator unsigned() const
+    constexpr operator interface_type() const
     {
-        return value_;
-    }
-    template <bit_field_signedness S = Signedness,
-              std::enable_if_t<S == bit_field_signed, int> = 0>
-    constexpr operator int() const
-    {
-        return static_cast<std::make_signed_t<value_type>>(value_);
+        if constexpr (Signedness == bit_field_unsigned) {
+            return value_;
+        } else {
+            return static_cast<std::make_signed_t<value_type>>(value_);
+        }
     }
 
 private:
@@ -158,10 +230,14 @@ template <std::size_t N, bit_field_signedness S>
 constexpr auto operator<=>(const bit_field<N, S>& lhs,
                            const bit_field<N, S>& rhs)
 {
+    using unsigned_type = typename bit_field<N, S>::unsigned_type;
+    using signed_type = typename bit_field<N, S>::signed_type;
     if constexpr (S == bit_field_unsigned) {
-        return static_cast<unsigned>(lhs) <=> static_cast<unsigned>(rhs);
+        return static_cast<unsigned_type>(lhs) <=>
+               static_cast<unsigned_type>(rhs);
     } else {
-        return static_cast<int>(lhs) <=> static_cast<int>(rhs);
+        return static_cast<signed_type>(lhs) <=>
+               static_cast<signed_type>(rhs);
     }
 }
 
@@ -178,10 +254,14 @@ template <std::size_t N, bit_field_signedness S>
 constexpr bool operator<(const bit_field<N, S>& lhs,
                          const bit_field<N, S>& rhs)
 {
+    using unsigned_type = typename bit_field<N, S>::unsigned_type;
+    using signed_type = typename bit_field<N, S>::signed_type;
     if constexpr (S == bit_field_unsigned) {
-        return static_cast<unsigned>(lhs) < static_cast<unsigned>(rhs);
+        return static_cast<unsigned_type>(lhs) <
+               static_cast<unsigned_type>(rhs);
     } else {
-        return static_cast<int>(lhs) < static_cast<int>(rhs);
+        return static_cast<signed_type>(lhs) <
+               static_cast<signed_type>(rhs);
     }
 }
 
@@ -232,6 +312,216 @@ constexpr std::size_t count_bit_fields()
     return result;
 }
 
+namespace detail {
+
+// Bit offset of a field from the least significant bit of the packed bits
+template <typename T, std::size_t I>
+constexpr unsigned get_bit_field_offset()
+{
+    std::size_t result = count_bit_fields<T>();
+    mozi::for_each_meta<T>([&](auto index, auto /*name*/, auto type) {
+        if (index <= I) {
+            result -= decltype(type)::type::length;
+        }
+    });
+    return static_cast<unsigned>(result);
+}
+
+template <typename T>
+using bit_fields_storage_t =
+    typename bit_fields_storage<count_bit_fields<T>()>::type;
+
+} // namespace detail
+
+// Packs the fields of a bit-fields container together, the first field in
+// the most significant bits.  This is also the net_pack wire format.
+template <typename T,
+          std::enable_if_t<mozi::is_bit_fields_container_v<T>, int> = 0>
+constexpr auto pack_bit_fields(const T& obj)
+{
+    detail::bit_fields_storage_t<T> result{};
+    mozi::for_each(obj, [&](auto index, auto /*name*/, const auto& field) {
+        constexpr unsigned offset =
+            detail::get_bit_field_offset<T, decltype(index)::value>();
+        constexpr unsigned len = remove_cvref_t<decltype(field)>::length;
+        detail::set_storage_bits<offset, len>(result,
+                                              field.underlying_value());
+    });
+    return result;
+}
+
+template <typename T,
+          std::enable_if_t<mozi::is_bit_fields_container_v<T>, int> = 0>
+constexpr void
+unpack_bit_fields(T& obj, const detail::bit_fields_storage_t<T>& bits)
+{
+    mozi::for_each(obj, [&](auto index, auto /*name*/, auto& field) {
+        using field_type = remove_cvref_t<decltype(field)>;
+        constexpr unsigned offset =
+            detail::get_bit_field_offset<T, decltype(index)::value>();
+        auto value =
+            detail::get_storage_bits<offset, field_type::length>(bits);
+        if constexpr (field_type::signedness == bit_field_signed) {
+            field = static_cast<typename field_type::signed_type>(value);
+        } else {
+            field = static_cast<typename field_type::unsigned_type>(value);
+        }
+    });
+}
+
+namespace detail {
+
+// Number of containers processed at a time by the bulk functions, so that
+// the containers stay in cache while the fields are processed one by one
+inline constexpr std::size_t bit_fields_bulk_chunk_size = 256;
+
+} // namespace detail
+
+// Packs an array of bit-fields containers.  The work is done a field at a
+// time across a chunk of containers, so that each pass is a simple loop of
+// shifts and masks, which compilers can vectorize.
+template <typename T,
+          std::enable_if_t<mozi::is_bit_fields_container_v<T>, int> = 0>
+constexpr void pack_bit_fields(const T* objs, std::size_t count,
+                               detail::bit_fields_storage_t<T>* dest)
+{
+    while (count != 0) {
+        auto n = count < detail::bit_fields_bulk_chunk_size
+                     ? count
+                     : detail::bit_fields_bulk_chunk_size;
+        for (std::size_t i = 0; i < n; ++i) {
+            dest[i] = detail::bit_fields_storage_t<T>{};
+        }
+        mozi::for_each_meta<T>([&](auto index, auto /*name*/, auto type) {
+            constexpr std::size_t I = decltype(index)::value;
+            constexpr auto offset = detail::get_bit_field_offset<T, I>();
+            constexpr unsigned len = decltype(type)::type::length;
+            for (std::size_t i = 0; i < n; ++i) {
+                detail::set_storage_bits<offset, len>(
+                    dest[i], mozi::get<I>(objs[i]).underlying_value());
+            }
+        });
+        objs += n;
+        dest += n;
+        count -= n;
+    }
+}
+
+// Unpacks an array of bit-fields containers, a field at a time like the
+// bulk pack_bit_fields
+template <typename T,
+          std::enable_if_t<mozi::is_bit_fields_container_v<T>, int> = 0>
+constexpr void unpack_bit_fields(T* objs, std::size_t count,
+                                 const detail::bit_fields_storage_t<T>* src)
+{
+    while (count != 0) {
+        auto n = count < detail::bit_fields_bulk_chunk_size
+                     ? count
+                     : detail::bit_fields_bulk_chunk_size;
+        mozi::for_each_meta<T>([&](auto index, auto /*name*/, auto type) {
+            using field_type = typename decltype(type)::type;
+            constexpr std::size_t I = decltype(index)::value;
+            constexpr auto offset = detail::get_bit_field_offset<T, I>();
+            using signed_type = typename field_type::signed_type;
+            using unsigned_type = typename field_type::unsigned_type;
+            for (std::size_t i = 0; i < n; ++i) {
+                auto value =
+                    detail::get_storage_bits<offset, field_type::length>(
+                        src[i]);
+                if constexpr (field_type::signedness == bit_field_signed) {
+                    mozi::get<I>(objs[i]) = static_cast<signed_type>(value);
+                } else {
+                    mozi::get<I>(objs[i]) =
+                        static_cast<unsigned_type>(value);
+                }
+            }
+        });
+        objs += n;
+        src += n;
+        count -= n;
+    }
+}
+
+// Proxy to a bit field kept at a bit offset in the storage of a packed
+// bit-fields container.  Reads and writes are shifts and masks on the
+// storage.
+template <typename Storage, unsigned Offset, typename BitField>
+class bit_field_ref {
+public:
+    using storage_type = std::remove_const_t<Storage>;
+    using value_type = typename BitField::value_type;
+    using unsigned_type = typename BitField::unsigned_type;
+    using signed_type = typename BitField::signed_type;
+    using interface_type = typename BitField::interface_type;
+    static constexpr std::size_t length = BitField::length;
+    static constexpr auto signedness = BitField::signedness;
+    static_assert(Offset + length <= sizeof(storage_type) * CHAR_BIT);
+
+    constexpr explicit bit_field_ref(Storage& bits) noexcept : bits_(bits)
+    {
+    }
+    bit_field_ref(const bit_field_ref&) = default;
+
+    // Assignments change the referred field, like those of bit_field
+    constexpr bit_field_ref& operator=(BitField value) noexcept
+    {
+        store(value.underlying_value());
+        return *this;
+    }
+    constexpr bit_field_ref& operator=(const bit_field_ref& rhs) noexcept
+    {
+        store(rhs.underlying_value());
+        return *this;
+    }
+    template <typename S, unsigned O>
+    constexpr bit_field_ref&
+    operator=(const bit_field_ref<S, O, BitField>& rhs) noexcept
+    {
+        store(rhs.underlying_value());
+        return *this;
+    }
+
+    constexpr value_type underlying_value() const noexcept
+    {
+        return static_cast<value_type>(
+            detail::get_storage_bits<Offset, length>(bits_));
+    }
+
+    constexpr operator interface_type() const noexcept
+    {
+        unsigned_type value = underlying_value();
+        if constexpr (signedness == bit_field_unsigned) {
+            return value;
+        } else {
+            // Sign-extended, assuming two's-complement representation
+            if ((value & (unsigned_type{1} << (length - 1))) != 0) {
+                value |= ~detail::get_bit_field_mask<unsigned_type>(length);
+            }
+            return static_cast<signed_type>(value);
+        }
+    }
+
+private:
+    constexpr void store(value_type value) noexcept
+    {
+        detail::set_storage_bits<Offset, length>(bits_, value);
+    }
+
+    Storage& bits_;
+};
+
+namespace detail {
+
+template <typename T, std::size_t I, typename Storage>
+constexpr auto make_bit_field_ref(Storage& bits) noexcept
+{
+    using field_type = typename T::template _field<T&, I>::type;
+    return bit_field_ref<Storage, get_bit_field_offset<T, I>(),
+                         field_type>(bits);
+}
+
+} // namespace detail
+
 } // namespace mozi
 
 #define MOZI_DEFINE_BIT_FIELDS_CONTAINER(st, ...)                          \
@@ -245,9 +535,58 @@ constexpr std::size_t count_bit_fields()
         MOZI_REPEAT_ON(MOZI_FIELD, __VA_ARGS__)                            \
     }
 
+#define MOZI_PACKED_BIT_FIELD(i, arg)                                      \
+    constexpr auto MOZI_STRIP(arg)() noexcept                              \
+    {                                                                      \
+        return mozi::detail::make_bit_field_ref<unpacked_type, i>(_bits);  \
+    }                                                                      \
+    constexpr auto MOZI_STRIP(arg)() const noexcept                        \
+    {                                                                      \
+        return mozi::detail::make_bit_field_ref<unpacked_type, i>(_bits);  \
+    }
+
+// Defines a bit-fields container that keeps all the fields packed in one
+// word, or several 64-bit words for more than 64 bits, in the layout of
+// pack_bit_fields.  Fields are accessed through member functions returning
+// bit_field_ref proxies, and unpacked_type is the equivalent container
+// defined by MOZI_DEFINE_BIT_FIELDS_CONTAINER.
+#define MOZI_DEFINE_PACKED_BIT_FIELDS_CONTAINER(st, ...)                   \
+    struct st {                                                            \
+        MOZI_DEFINE_BIT_FIELDS_CONTAINER(unpacked_type, __VA_ARGS__);      \
+        using is_mozi_packed_bit_fields_container = void;                  \
+        using storage_type =                                               \
+            mozi::detail::bit_fields_storage_t<unpacked_type>;             \
+        storage_type _bits;                                                \
+        static constexpr st pack(const unpacked_type& obj) noexcept        \
+        {                                                                  \
+            return st{mozi::pack_bit_fields(obj)};                         \
+        }                                                                  \
+        constexpr unpacked_type unpack() const noexcept                    \
+        {                                                                  \
+            unpacked_type result{};                                        \
+            mozi::unpack_bit_fields(result, _bits);                        \
+            return result;                                                 \
+        }                                                                  \
+        friend constexpr bool operator==(const st& lhs, const st& rhs)     \
+        {                                                                  \
+            return lhs._bits == rhs._bits;                                 \
+        }                                                                  \
+        friend constexpr bool operator!=(const st& lhs, const st& rhs)     \
+        {                                                                  \
+            return !(lhs == rhs);                                          \
+        }                                                                  \
+        MOZI_REPEAT_ON(MOZI_PACKED_BIT_FIELD, __VA_ARGS__)                 \
+    }
+
 #if !defined(DEFINE_BIT_FIELDS_CONTAINER) &&                               \
     !defined(MOZI_NO_DEFINE_BIT_FIELDS_CONTAINER)
 #define DEFINE_BIT_FIELDS_CONTAINER MOZI_DEFINE_BIT_FIELDS_CONTAINER
 #endif
 
+#if !defined(DEFINE_PACKED_BIT_FIELDS_CONTAINER) &&                        \
+    !defined(MOZI_NO_DEFINE_PACKED_BIT_FIELDS_CONTAINER)
+#define DEFINE_PACKED_BIT_FIELDS_CONTAINER                                 \
+    MOZI_DEFINE_PACKED_BIT_FIELDS_CONTAINER
+#endif
+
 #endif // MOZI_BIT_FIELDS_CORE_HPP
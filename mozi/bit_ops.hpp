@@ -0,0 +1,98 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_BIT_OPS_HPP
+#define MOZI_BIT_OPS_HPP
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <version>     // IWYU pragma: keep
+#endif
+
+#if __cpp_lib_bitops >= 201907L
+#include <bit>         // std::countr_zero/popcount
+#endif
+
+#include <climits>     // CHAR_BIT
+#include <type_traits> // std::is_unsigned
+
+namespace mozi {
+
+// Number of consecutive zero bits, starting from the least significant
+// bit.  The result is the bit width of the type when value is zero.
+template <typename T>
+constexpr int countr_zero(T value)
+{
+    static_assert(std::is_unsigned_v<T>,
+                  "Only unsigned integers are supported");
+#if __cpp_lib_bitops >= 201907L
+    return std::countr_zero(value);
+#else
+    if (value == 0) {
+        return static_cast<int>(sizeof(T) * CHAR_BIT);
+    }
+#if defined(__GNUC__)
+    if constexpr (sizeof(T) <= sizeof(unsigned)) {
+        return __builtin_ctz(value);
+    } else if constexpr (sizeof(T) <= sizeof(unsigned long)) {
+        return __builtin_ctzl(value);
+    } else {
+        return __builtin_ctzll(value);
+    }
+#else
+    int result = 0;
+    while ((value & 1U) == 0) {
+        value = static_cast<T>(value >> 1);
+        ++result;
+    }
+    return result;
+#endif
+#endif
+}
+
+// Number of one bits
+template <typename T>
+constexpr int popcount(T value)
+{
+    static_assert(std::is_unsigned_v<T>,
+                  "Only unsigned integers are supported");
+#if __cpp_lib_bitops >= 201907L
+    return std::popcount(value);
+#elif defined(__GNUC__)
+    if constexpr (sizeof(T) <= sizeof(unsigned)) {
+        return __builtin_popcount(value);
+    } else if constexpr (sizeof(T) <= sizeof(unsigned long)) {
+        return __builtin_popcountl(value);
+    } else {
+        return __builtin_popcountll(value);
+    }
+#else
+    int result = 0;
+    while (value != 0) {
+        value = static_cast<T>(value & (value - 1U));
+        ++result;
+    }
+    return result;
+#endif
+}
+
+} // namespace mozi
+
+#endif // MOZI_BIT_OPS_HPP
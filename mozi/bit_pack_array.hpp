@@ -0,0 +1,90 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_BIT_PACK_ARRAY_HPP
+#define MOZI_BIT_PACK_ARRAY_HPP
+
+#include <array>             // std::array
+#include <cstddef>           // std::size_t
+#include "bit_pack_core.hpp" // mozi::bit_pack::serializer/...
+#include "serialization.hpp" // mozi::deserialize_result
+
+namespace mozi::bit_pack {
+
+namespace detail {
+
+template <typename T, typename Sink>
+void serialize_array(const T* arr, std::size_t size,
+                     bit_writer<Sink>& writer)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        serializer<T>::serialize(arr[i], writer);
+    }
+}
+
+template <typename T>
+deserialize_result deserialize_array(T* arr, std::size_t size,
+                                     bit_reader& reader)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        auto result = serializer<T>::deserialize(arr[i], reader);
+        if (result != deserialize_result::success) {
+            return result;
+        }
+    }
+    return deserialize_result::success;
+}
+
+} // namespace detail
+
+template <typename T, std::size_t N>
+struct serializer<T[N]> {
+    template <typename Sink>
+    static void serialize(const T (&arr)[N], bit_writer<Sink>& writer)
+    {
+        detail::serialize_array(arr, N, writer);
+    }
+
+    static deserialize_result deserialize(T (&arr)[N], bit_reader& reader)
+    {
+        return detail::deserialize_array(arr, N, reader);
+    }
+};
+
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> {
+    template <typename Sink>
+    static void serialize(const std::array<T, N>& arr,
+                          bit_writer<Sink>& writer)
+    {
+        detail::serialize_array(arr.data(), N, writer);
+    }
+
+    static deserialize_result deserialize(std::array<T, N>& arr,
+                                          bit_reader& reader)
+    {
+        return detail::deserialize_array(arr.data(), N, reader);
+    }
+};
+
+} // namespace mozi::bit_pack
+
+#endif // MOZI_BIT_PACK_ARRAY_HPP
@@ -0,0 +1,129 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_BIT_PACK_BASIC_HPP
+#define MOZI_BIT_PACK_BASIC_HPP
+
+#include <climits>             // CHAR_BIT
+#include <cstdint>             // std::uint64_t
+#include <type_traits>         // std::enable_if/is_integral/...
+#include "bit_fields_core.hpp" // mozi::bit_field
+#include "bit_pack_core.hpp"   // mozi::bit_pack::serializer/...
+#include "serialization.hpp"   // mozi::deserialize_result
+#include "type_traits.hpp"     // mozi::underlying_type_t
+
+namespace mozi::bit_pack {
+
+template <>
+struct serializer<bool> {
+    template <typename Sink>
+    static void serialize(bool value, bit_writer<Sink>& writer)
+    {
+        writer.write_bits(value, 1);
+    }
+
+    static deserialize_result deserialize(bool& value, bit_reader& reader)
+    {
+        std::uint64_t bits{};
+        if (!reader.read_bits(bits, 1)) {
+            return deserialize_result::input_truncated;
+        }
+        value = bits != 0;
+        return deserialize_result::success;
+    }
+};
+
+// Integers are written in two's complement in all their bits
+template <typename T>
+struct serializer<T, std::enable_if_t<std::is_integral_v<T>>> {
+    static constexpr unsigned bit_count = sizeof(T) * CHAR_BIT;
+
+    template <typename Sink>
+    static void serialize(T value, bit_writer<Sink>& writer)
+    {
+        writer.write_bits(static_cast<std::make_unsigned_t<T>>(value),
+                          bit_count);
+    }
+
+    static deserialize_result deserialize(T& value, bit_reader& reader)
+    {
+        std::uint64_t bits{};
+        if (!reader.read_bits(bits, bit_count)) {
+            return deserialize_result::input_truncated;
+        }
+        value = static_cast<T>(bits);
+        return deserialize_result::success;
+    }
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using underlying_type = mozi::underlying_type_t<T>;
+
+    template <typename Sink>
+    static void serialize(T value, bit_writer<Sink>& writer)
+    {
+        serializer<underlying_type>::serialize(
+            static_cast<underlying_type>(value), writer);
+    }
+
+    static deserialize_result deserialize(T& value, bit_reader& reader)
+    {
+        underlying_type temp{};
+        auto result =
+            serializer<underlying_type>::deserialize(temp, reader);
+        if (result == deserialize_result::success) {
+            value = static_cast<T>(temp);
+        }
+        return result;
+    }
+};
+
+// A bit field takes exactly its length in bits
+template <std::size_t N, bit_field_signedness Signedness>
+struct serializer<bit_field<N, Signedness>> {
+    using value_type = bit_field<N, Signedness>;
+
+    template <typename Sink>
+    static void serialize(const value_type& value, bit_writer<Sink>& writer)
+    {
+        writer.write_bits(value.underlying_value(), N);
+    }
+
+    static deserialize_result deserialize(value_type& value,
+                                          bit_reader& reader)
+    {
+        std::uint64_t bits{};
+        if (!reader.read_bits(bits, N)) {
+            return deserialize_result::input_truncated;
+        }
+        if constexpr (Signedness == bit_field_signed) {
+            value = static_cast<typename value_type::signed_type>(bits);
+        } else {
+            value = static_cast<typename value_type::unsigned_type>(bits);
+        }
+        return deserialize_result::success;
+    }
+};
+
+} // namespace mozi::bit_pack
+
+#endif // MOZI_BIT_PACK_BASIC_HPP
@@ -0,0 +1,262 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_BIT_PACK_CORE_HPP
+#define MOZI_BIT_PACK_CORE_HPP
+
+// bit_pack is a serializer family for bit-packed protocols.  Every value
+// occupies exactly its width in bits: a bool takes one bit, a bit field
+// its length, and an integer its size in bits.  Consecutive values, and
+// consecutive containers written to the same bit_writer, follow one
+// another with no padding, the most significant bit first.  Only the end
+// of the stream is padded with zero bits to a whole byte.
+//
+// Unlike the other serializer families, the serializers work on a
+// bit_writer or bit_reader instead of a sink or a byte span, so bit_pack
+// cannot be combined with other families in a serializer list.
+
+#include <array>             // std::array
+#include <climits>           // CHAR_BIT
+#include <cstddef>           // std::byte/size_t
+#include <cstdint>           // std::uint64_t
+#include "serialization.hpp" // mozi::serialize_t/deserialize_t/...
+
+namespace mozi::bit_pack {
+
+template <typename T, typename = void>
+struct serializer;
+
+namespace detail {
+
+constexpr std::uint64_t get_low_bits_mask(unsigned count)
+{
+    // Shift count overflow is undefined behavior
+    return count >= 64 ? ~std::uint64_t{} : ~(~std::uint64_t{} << count);
+}
+
+} // namespace detail
+
+// Writer of a bit stream to a sink.  Bits are collected in a 64-bit
+// accumulator, which is written out as a whole word when it is full.
+// flush must be called at the end of the stream.
+template <typename Sink>
+class bit_writer {
+public:
+    static_assert(CHAR_BIT == 8);
+    static_assert(is_sink_v<Sink>, "Destination must be a sink");
+
+    explicit bit_writer(Sink& dest) : dest_(dest) {}
+    bit_writer(const bit_writer&) = delete;
+    bit_writer& operator=(const bit_writer&) = delete;
+
+    // Writes the low count bits of value, where count <= 64
+    void write_bits(std::uint64_t value, unsigned count)
+    {
+        if (count == 0) {
+            return;
+        }
+        value &= detail::get_low_bits_mask(count);
+        unsigned free_bits = 64 - used_bits_;
+        if (count < free_bits) {
+            accumulator_ |= value << (free_bits - count);
+            used_bits_ += count;
+        } else {
+            accumulator_ |= value >> (count - free_bits);
+            write_word(accumulator_, 8);
+            used_bits_ = count - free_bits;
+            accumulator_ =
+                used_bits_ == 0 ? 0 : value << (64 - used_bits_);
+        }
+    }
+
+    // Writes the remaining bits, padded with zero bits to a whole byte
+    void flush()
+    {
+        write_word(accumulator_, (used_bits_ + 7) / 8);
+        accumulator_ = 0;
+        used_bits_ = 0;
+    }
+
+    Sink& sink() const
+    {
+        return dest_;
+    }
+
+private:
+    void write_word(std::uint64_t word, std::size_t size)
+    {
+        std::array<std::byte, 8> bytes{};
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<std::byte>(word >> (56 - i * 8));
+        }
+        sink_traits<Sink>::write(dest_, bytes.data(), size);
+    }
+
+    Sink& dest_;
+    std::uint64_t accumulator_{};
+    unsigned used_bits_{};
+};
+
+// Reader of a bit stream from a byte span.  Input is loaded into a 64-bit
+// accumulator a whole word at a time when possible.
+class bit_reader {
+public:
+    explicit bit_reader(deserialize_t src) : src_(src) {}
+
+    // Reads count bits into the low bits of value, where count <= 64.
+    // Returns false if the input is exhausted.
+    bool read_bits(std::uint64_t& value, unsigned count)
+    {
+        if (available_bits_ < count) {
+            refill();
+        }
+        if (available_bits_ >= count) {
+            value = count == 0 ? 0 : accumulator_ >> (64 - count);
+            consume(count);
+            return true;
+        }
+        // The accumulator cannot hold all the bits needed: take its bits
+        // first
+        unsigned high_count = available_bits_;
+        if (high_count == 0) {
+            return false;
+        }
+        auto high_bits = accumulator_ >> (64 - high_count);
+        consume(high_count);
+        refill();
+        unsigned low_count = count - high_count;
+        if (available_bits_ < low_count) {
+            return false;
+        }
+        value = (high_bits << low_count) |
+                (accumulator_ >> (64 - low_count));
+        consume(low_count);
+        return true;
+    }
+
+    // Returns the input after the byte containing the last bit read
+    deserialize_t remaining() const
+    {
+        return src_.subspan(pos_ - available_bits_ / 8);
+    }
+
+    // Checks that the unread bits of the current byte are zero, as
+    // written by bit_writer::flush
+    bool is_padding_zero() const
+    {
+        unsigned padding = available_bits_ % 8;
+        return padding == 0 || (accumulator_ >> (64 - padding)) == 0;
+    }
+
+private:
+    void refill()
+    {
+        if (available_bits_ == 0 && src_.size() - pos_ >= 8) {
+            accumulator_ = 0;
+            for (std::size_t i = 0; i < 8; ++i) {
+                accumulator_ = (accumulator_ << 8) |
+                               static_cast<unsigned char>(src_[pos_ + i]);
+            }
+            pos_ += 8;
+            available_bits_ = 64;
+            return;
+        }
+        while (available_bits_ <= 56 && pos_ < src_.size()) {
+            accumulator_ |=
+                std::uint64_t{static_cast<unsigned char>(src_[pos_])}
+                << (56 - available_bits_);
+            ++pos_;
+            available_bits_ += 8;
+        }
+    }
+
+    void consume(unsigned count)
+    {
+        accumulator_ = count >= 64 ? 0 : accumulator_ << count;
+        available_bits_ -= count;
+    }
+
+    deserialize_t src_;
+    std::size_t pos_{};
+    std::uint64_t accumulator_{};
+    unsigned available_bits_{};
+};
+
+namespace detail {
+
+struct serialize_fn {
+    template <typename T, typename Sink>
+    void operator()(const T& value, bit_writer<Sink>& writer) const
+    {
+        serializer<T>::serialize(value, writer);
+    }
+
+    template <typename T, typename Sink>
+    serialize_result operator()(const T& value, Sink& dest) const
+    {
+        bit_writer<Sink> writer(dest);
+        serializer<T>::serialize(value, writer);
+        writer.flush();
+        return sink_traits<Sink>::overflowed(dest)
+                   ? serialize_result::output_overflow
+                   : serialize_result::success;
+    }
+
+    template <typename T>
+    serialize_t operator()(const T& value) const
+    {
+        serialize_t result;
+        operator()(value, result);
+        return result;
+    }
+};
+
+struct deserialize_fn {
+    template <typename T>
+    deserialize_result operator()(T& value, bit_reader& reader) const
+    {
+        return serializer<T>::deserialize(value, reader);
+    }
+
+    // Deserializes a whole stream, which shall end with zero padding bits
+    template <typename T>
+    deserialize_result operator()(T& value, deserialize_t& src) const
+    {
+        bit_reader reader(src);
+        auto result = serializer<T>::deserialize(value, reader);
+        if (result == deserialize_result::success) {
+            if (!reader.is_padding_zero()) {
+                return deserialize_result::unexpected_input_data;
+            }
+            src = reader.remaining();
+        }
+        return result;
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::serialize_fn serialize{};
+inline constexpr detail::deserialize_fn deserialize{};
+
+} // namespace mozi::bit_pack
+
+#endif // MOZI_BIT_PACK_CORE_HPP
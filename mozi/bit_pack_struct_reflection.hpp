@@ -0,0 +1,126 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_BIT_PACK_STRUCT_REFLECTION_HPP
+#define MOZI_BIT_PACK_STRUCT_REFLECTION_HPP
+
+#include <cstddef>                    // std::size_t
+#include <cstdint>                    // std::uint64_t
+#include <type_traits>                // std::enable_if
+#include <utility>                    // std::index_sequence
+#include "bit_fields_core.hpp"        // mozi::count_bit_fields/...
+#include "bit_pack_core.hpp"          // mozi::bit_pack::serializer/...
+#include "serialization.hpp"          // mozi::deserialize_result
+#include "struct_reflection_core.hpp" // mozi::for_each/get
+#include "type_traits.hpp"            // mozi::is_reflected_struct/...
+
+namespace mozi::bit_pack {
+
+// Fields of reflected structs, including bit-fields containers, are
+// written one after another
+template <typename T>
+struct serializer<T, std::enable_if_t<mozi::is_reflected_struct_v<T>>> {
+    template <typename Sink>
+    static void serialize(const T& obj, bit_writer<Sink>& writer)
+    {
+        mozi::for_each(
+            obj, [&](auto /*index*/, auto /*name*/, const auto& value) {
+                serializer<remove_cvref_t<decltype(value)>>::serialize(
+                    value, writer);
+            });
+    }
+
+    static deserialize_result deserialize(T& obj, bit_reader& reader)
+    {
+        return deserialize_fields(obj, reader,
+                                  std::make_index_sequence<T::_size>{});
+    }
+
+private:
+    template <std::size_t... Is>
+    static deserialize_result deserialize_fields(T& obj, bit_reader& reader,
+                                                 std::index_sequence<Is...>)
+    {
+        auto result = deserialize_result::success;
+        (void)((result = deserialize_field<Is>(obj, reader),
+                result == deserialize_result::success) &&
+               ...);
+        return result;
+    }
+
+    template <std::size_t I>
+    static deserialize_result deserialize_field(T& obj, bit_reader& reader)
+    {
+        using field_type = typename T::template _field<T, I>::type;
+        return serializer<field_type>::deserialize(mozi::get<I>(obj),
+                                                   reader);
+    }
+};
+
+// A packed bit-fields container is written from its storage, the most
+// significant word first
+template <typename T>
+struct serializer<
+    T, std::enable_if_t<mozi::is_packed_bit_fields_container_v<T>>> {
+    static constexpr unsigned bit_count =
+        count_bit_fields<typename T::unpacked_type>();
+    static constexpr unsigned top_bit_count = (bit_count - 1) % 64 + 1;
+
+    template <typename Sink>
+    static void serialize(const T& obj, bit_writer<Sink>& writer)
+    {
+        if constexpr (bit_count <= 64) {
+            writer.write_bits(obj._bits, bit_count);
+        } else {
+            auto i = obj._bits.size() - 1;
+            writer.write_bits(obj._bits[i], top_bit_count);
+            while (i != 0) {
+                writer.write_bits(obj._bits[--i], 64);
+            }
+        }
+    }
+
+    static deserialize_result deserialize(T& obj, bit_reader& reader)
+    {
+        std::uint64_t bits{};
+        if constexpr (bit_count <= 64) {
+            if (!reader.read_bits(bits, bit_count)) {
+                return deserialize_result::input_truncated;
+            }
+            obj._bits = static_cast<typename T::storage_type>(bits);
+        } else {
+            auto i = obj._bits.size() - 1;
+            if (!reader.read_bits(obj._bits[i], top_bit_count)) {
+                return deserialize_result::input_truncated;
+            }
+            while (i != 0) {
+                if (!reader.read_bits(obj._bits[--i], 64)) {
+                    return deserialize_result::input_truncated;
+                }
+            }
+        }
+        return deserialize_result::success;
+    }
+};
+
+} // namespace mozi::bit_pack
+
+#endif // MOZI_BIT_PACK_STRUCT_REFLECTION_HPP
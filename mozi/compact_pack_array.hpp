@@ -0,0 +1,121 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_COMPACT_PACK_ARRAY_HPP
+#define MOZI_COMPACT_PACK_ARRAY_HPP
+
+#include <array>                  // std::array
+#include <cstddef>                // std::byte/size_t
+#include <type_traits>            // std::is_same
+#include "compact_pack_basic.hpp" // mozi::compact_pack::detail::bitmap_size
+#include "compact_pack_core.hpp"  // mozi::compact_pack::serializer/...
+#include "serialization.hpp"      // mozi::serialize/deserialize/...
+
+namespace mozi::compact_pack {
+
+namespace detail {
+
+template <typename T, std::size_t N, typename Sink,
+          typename SerializerList>
+void serialize_array(const T* arr, Sink& dest, SerializerList serializers)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        std::array<std::byte, bitmap_size(N)> bitmap{};
+        for (std::size_t i = 0; i < N; ++i) {
+            set_bitmap_bit(bitmap.data(), i, arr[i]);
+        }
+        sink_traits<Sink>::write(dest, bitmap.data(), bitmap.size());
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            mozi::serialize(arr[i], dest, serializers);
+        }
+    }
+}
+
+template <typename T, std::size_t N, typename SerializerList>
+deserialize_result deserialize_array(T* arr, deserialize_t& src,
+                                     SerializerList serializers)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        constexpr auto size = bitmap_size(N);
+        if (src.size() < size) {
+            return deserialize_result::input_truncated;
+        }
+        if (!check_bitmap_padding(src.data(), N)) {
+            return deserialize_result::invalid_value;
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            arr[i] = get_bitmap_bit(src.data(), i);
+        }
+        src = src.subspan(size);
+        return deserialize_result::success;
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto result = mozi::deserialize(arr[i], src, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+        return deserialize_result::success;
+    }
+}
+
+} // namespace detail
+
+template <typename T, std::size_t N>
+struct serializer<T[N]> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T (&arr)[N], Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_array<T, N>(arr, dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T (&arr)[N], deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return detail::deserialize_array<T, N>(arr, src, serializers);
+    }
+};
+
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const std::array<T, N>& arr, Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_array<T, N>(arr.data(), dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(std::array<T, N>& arr,
+                                          deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return detail::deserialize_array<T, N>(arr.data(), src,
+                                               serializers);
+    }
+};
+
+} // namespace mozi::compact_pack
+
+#endif // MOZI_COMPACT_PACK_ARRAY_HPP
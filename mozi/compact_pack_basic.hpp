@@ -0,0 +1,301 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_COMPACT_PACK_BASIC_HPP
+#define MOZI_COMPACT_PACK_BASIC_HPP
+
+#include <array>                 // std::array
+#include <climits>               // CHAR_BIT
+#include <cstddef>               // std::byte/size_t
+#include <cstdint>               // std::uint64_t
+#include <cstring>               // std::memcpy
+#include <limits>                // std::numeric_limits
+#include <type_traits>           // std::enable_if/is_integral/...
+#include "bit_ops.hpp"           // mozi::countr_zero
+#include "compact_pack_core.hpp" // mozi::compact_pack::serializer/...
+#include "endian.hpp"            // mozi::native_endian/byte_swap
+#include "serialization.hpp"     // mozi::deserialize_result/...
+#include "type_traits.hpp"       // mozi::is_ordinary_char/...
+
+namespace mozi::compact_pack {
+
+namespace detail {
+
+// Maximum size of the LEB128 encoding of an unsigned type
+template <typename U>
+inline constexpr std::size_t max_varint_size =
+    (sizeof(U) * CHAR_BIT + 6) / 7;
+
+template <typename U, typename Sink>
+void serialize_varint(U value, Sink& dest)
+{
+    static_assert(std::is_unsigned_v<U> && sizeof(U) <= 8);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    std::array<std::byte, max_varint_size<U>> buffer;
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        buffer[size++] = static_cast<std::byte>((value & 0x7F) | 0x80);
+        value = static_cast<U>(value >> 7);
+    }
+    buffer[size++] = static_cast<std::byte>(value);
+    sink_traits<Sink>::write(dest, buffer.data(), size);
+}
+
+// Loads 8 bytes as a little-endian integer
+inline std::uint64_t load_le64(const std::byte* src)
+{
+    std::uint64_t word{};
+    if constexpr (native_endian == endian::little) {
+        std::memcpy(&word, src, sizeof word);
+    } else if constexpr (native_endian == endian::big) {
+        std::memcpy(&word, src, sizeof word);
+        word = byte_swap(word);
+    } else {
+        for (std::size_t i = 0; i < sizeof word; ++i) {
+            word |= static_cast<std::uint64_t>(src[i]) << (i * CHAR_BIT);
+        }
+    }
+    return word;
+}
+
+template <typename U>
+deserialize_result deserialize_varint_slow(U& value, deserialize_t& src)
+{
+    constexpr auto bits = sizeof(U) * CHAR_BIT;
+    std::uint64_t result{};
+    for (std::size_t i = 0; i < max_varint_size<U>; ++i) {
+        if (i == src.size()) {
+            return deserialize_result::input_truncated;
+        }
+        auto byte = static_cast<std::uint64_t>(src[i]);
+        auto group = byte & 0x7F;
+        if (7 * i + 7 > bits && (group >> (bits - 7 * i)) != 0) {
+            return deserialize_result::invalid_value;
+        }
+        result |= group << (7 * i);
+        if ((byte & 0x80) == 0) {
+            if (i > 0 && byte == 0) {
+                return deserialize_result::invalid_value;
+            }
+            value = static_cast<U>(result);
+            src = src.subspan(i + 1);
+            return deserialize_result::success;
+        }
+    }
+    return deserialize_result::invalid_value;
+}
+
+// Decodes a LEB128 integer.  When at least 8 bytes are available, the
+// length is found with a single bit scan over the continuation bits, and
+// the 7-bit groups are joined by a fixed sequence of mask-and-shift
+// operations, so there is no branch per byte.  Non-minimal encodings
+// (a zero final byte after the first one) are rejected, so that each
+// value has exactly one valid encoding.
+template <typename U>
+deserialize_result deserialize_varint(U& value, deserialize_t& src)
+{
+    static_assert(std::is_unsigned_v<U> && sizeof(U) <= 8);
+    constexpr std::uint64_t stop_mask = 0x8080808080808080;
+    if (src.size() >= 8) {
+        auto word = load_le64(src.data());
+        auto stop_bits = ~word & stop_mask;
+        if (stop_bits != 0) {
+            auto size = static_cast<std::size_t>(countr_zero(stop_bits)) /
+                            CHAR_BIT +
+                        1;
+            word &= ~std::uint64_t{} >> (64 - size * CHAR_BIT);
+            word &= 0x7F7F7F7F7F7F7F7F;
+            word = (word & 0x007F007F007F007F) |
+                   ((word & 0x7F007F007F007F00) >> 1);
+            word = (word & 0x00003FFF00003FFF) |
+                   ((word & 0x3FFF00003FFF0000) >> 2);
+            word = (word & 0x000000000FFFFFFF) |
+                   ((word & 0x0FFFFFFF00000000) >> 4);
+            if (size > max_varint_size<U> ||
+                (size > 1 && src[size - 1] == std::byte{}) ||
+                word > std::numeric_limits<U>::max()) {
+                return deserialize_result::invalid_value;
+            }
+            value = static_cast<U>(word);
+            src = src.subspan(size);
+            return deserialize_result::success;
+        }
+    }
+    return deserialize_varint_slow(value, src);
+}
+
+template <typename T>
+constexpr std::make_unsigned_t<T> zigzag_encode(T value)
+{
+    using unsigned_type = std::make_unsigned_t<T>;
+    auto unsigned_value = static_cast<unsigned_type>(value);
+    auto sign = static_cast<unsigned_type>(
+        unsigned_type{} - (unsigned_value >> (sizeof(T) * CHAR_BIT - 1)));
+    return static_cast<unsigned_type>(
+        static_cast<unsigned_type>(unsigned_value << 1) ^ sign);
+}
+
+template <typename T>
+constexpr T zigzag_decode(std::make_unsigned_t<T> value)
+{
+    using unsigned_type = std::make_unsigned_t<T>;
+    auto sign =
+        static_cast<unsigned_type>(unsigned_type{} - (value & 1U));
+    return static_cast<T>(static_cast<unsigned_type>(value >> 1) ^ sign);
+}
+
+// Bools are packed into a bitmap, from the least significant bit of the
+// first byte.  Unused bits in the last byte must be zero.
+constexpr std::size_t bitmap_size(std::size_t count)
+{
+    return (count + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+inline void set_bitmap_bit(std::byte* bitmap, std::size_t index,
+                           bool value)
+{
+    bitmap[index / CHAR_BIT] |=
+        static_cast<std::byte>(static_cast<unsigned>(value)
+                               << (index % CHAR_BIT));
+}
+
+inline bool get_bitmap_bit(const std::byte* bitmap, std::size_t index)
+{
+    return ((bitmap[index / CHAR_BIT] >> (index % CHAR_BIT)) &
+            std::byte{1}) != std::byte{0};
+}
+
+inline bool check_bitmap_padding(const std::byte* bitmap,
+                                 std::size_t count)
+{
+    if (count % CHAR_BIT == 0) {
+        return true;
+    }
+    return (bitmap[count / CHAR_BIT] >> (count % CHAR_BIT)) ==
+           std::byte{0};
+}
+
+} // namespace detail
+
+template <>
+struct serializer<bool> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(bool value, Sink& dest,
+                          SerializerList /*unused*/)
+    {
+        sink_traits<Sink>::put(dest, std::byte{value});
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(bool& value, deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        if (src.empty()) {
+            return deserialize_result::input_truncated;
+        }
+        if (src.front() == std::byte{0}) {
+            value = false;
+        } else if (src.front() == std::byte{1}) {
+            value = true;
+        } else {
+            return deserialize_result::invalid_value;
+        }
+        src = src.subspan(1);
+        return deserialize_result::success;
+    }
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<is_ordinary_char_v<T>>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest, SerializerList /*unused*/)
+    {
+        sink_traits<Sink>::put(dest, static_cast<std::byte>(value));
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& value, deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        if (src.empty()) {
+            return deserialize_result::input_truncated;
+        }
+        value = static_cast<T>(src.front());
+        src = src.subspan(1);
+        return deserialize_result::success;
+    }
+};
+
+template <typename T>
+struct serializer<
+    T, std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest, SerializerList /*unused*/)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            detail::serialize_varint(detail::zigzag_encode(value), dest);
+        } else {
+            detail::serialize_varint(value, dest);
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& value, deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        std::make_unsigned_t<T> unsigned_value{};
+        auto result = detail::deserialize_varint(unsigned_value, src);
+        if (result == deserialize_result::success) {
+            if constexpr (std::is_signed_v<T>) {
+                value = detail::zigzag_decode<T>(unsigned_value);
+            } else {
+                value = unsigned_value;
+            }
+        }
+        return result;
+    }
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<std::is_enum_v<T>>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest, SerializerList serializers)
+    {
+        mozi::serialize(static_cast<mozi::underlying_type_t<T>>(value),
+                        dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& value, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        mozi::underlying_type_t<T> temp{};
+        auto result = mozi::deserialize(temp, src, serializers);
+        if (result == deserialize_result::success) {
+            value = static_cast<T>(temp);
+        }
+        return result;
+    }
+};
+
+} // namespace mozi::compact_pack
+
+#endif // MOZI_COMPACT_PACK_BASIC_HPP
@@ -0,0 +1,138 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_COMPACT_PACK_STRUCT_REFLECTION_HPP
+#define MOZI_COMPACT_PACK_STRUCT_REFLECTION_HPP
+
+#include <array>                      // std::array
+#include <cstddef>                    // std::byte/size_t
+#include <type_traits>                // std::enable_if/is_same
+#include <utility>                    // std::index_sequence
+#include "compact_pack_basic.hpp"     // mozi::compact_pack::detail::...
+#include "compact_pack_core.hpp"      // mozi::compact_pack::serializer
+#include "serialization.hpp"          // mozi::serialize/deserialize/...
+#include "struct_reflection_core.hpp" // mozi::for_each/get
+#include "type_traits.hpp"            // mozi::is_reflected_struct/...
+
+namespace mozi::compact_pack {
+
+namespace detail {
+
+template <typename T, std::size_t... Is>
+constexpr std::size_t count_bool_fields(std::index_sequence<Is...>)
+{
+    return (std::size_t{} + ... +
+            std::is_same_v<typename T::template _field<T, Is>::type,
+                           bool>);
+}
+
+} // namespace detail
+
+// All bool fields of a struct are packed into a bitmap, which precedes
+// the other fields.
+template <typename T>
+struct serializer<T,
+                  std::enable_if_t<mozi::is_reflected_struct_v<T> &&
+                                   !mozi::is_bit_fields_container_v<T>>> {
+    static constexpr std::size_t bool_count =
+        detail::count_bool_fields<T>(std::make_index_sequence<T::_size>{});
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& obj, Sink& dest,
+                          SerializerList serializers)
+    {
+        if constexpr (bool_count != 0) {
+            std::array<std::byte, detail::bitmap_size(bool_count)>
+                bitmap{};
+            std::size_t index = 0;
+            mozi::for_each(
+                obj, [&](auto /*index*/, auto /*name*/, const auto& value) {
+                    if constexpr (std::is_same_v<
+                                      remove_cvref_t<decltype(value)>,
+                                      bool>) {
+                        detail::set_bitmap_bit(bitmap.data(), index++,
+                                               value);
+                    }
+                });
+            sink_traits<Sink>::write(dest, bitmap.data(), bitmap.size());
+        }
+        mozi::for_each(
+            obj, [&](auto /*index*/, auto /*name*/, const auto& value) {
+                if constexpr (!std::is_same_v<
+                                  remove_cvref_t<decltype(value)>, bool>) {
+                    mozi::serialize(value, dest, serializers);
+                }
+            });
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& obj, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        auto input = src;
+        const std::byte* bitmap{};
+        if constexpr (bool_count != 0) {
+            constexpr auto size = detail::bitmap_size(bool_count);
+            if (input.size() < size) {
+                return deserialize_result::input_truncated;
+            }
+            if (!detail::check_bitmap_padding(input.data(), bool_count)) {
+                return deserialize_result::invalid_value;
+            }
+            bitmap = input.data();
+            input = input.subspan(size);
+        }
+        auto result =
+            deserialize_fields(obj, input, bitmap, serializers,
+                               std::make_index_sequence<T::_size>{});
+        if (result == deserialize_result::success) {
+            src = input;
+        }
+        return result;
+    }
+
+private:
+    template <typename SerializerList, std::size_t... Is>
+    static deserialize_result
+    deserialize_fields(T& obj, deserialize_t& src, const std::byte* bitmap,
+                       SerializerList serializers,
+                       std::index_sequence<Is...>)
+    {
+        auto result = deserialize_result::success;
+        std::size_t index = 0;
+        auto deserialize_field = [&](auto& value) {
+            if constexpr (std::is_same_v<remove_cvref_t<decltype(value)>,
+                                         bool>) {
+                value = detail::get_bitmap_bit(bitmap, index++);
+            } else {
+                result = mozi::deserialize(value, src, serializers);
+            }
+            return result == deserialize_result::success;
+        };
+        // Stop at the first failure
+        (void)(deserialize_field(mozi::get<Is>(obj)) && ...);
+        return result;
+    }
+};
+
+} // namespace mozi::compact_pack
+
+#endif // MOZI_COMPACT_PACK_STRUCT_REFLECTION_HPP
@@ -0,0 +1,90 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_ENDIAN_HPP
+#define MOZI_ENDIAN_HPP
+
+#include <climits>     // CHAR_BIT
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::is_unsigned
+
+#define MOZI_LITTLE_ENDIAN 1234
+#define MOZI_BIG_ENDIAN 4321
+
+#ifndef MOZI_BYTE_ORDER
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) &&        \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define MOZI_BYTE_ORDER MOZI_LITTLE_ENDIAN
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) &&         \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define MOZI_BYTE_ORDER MOZI_BIG_ENDIAN
+#elif defined(_MSC_VER) // All Windows platforms are little-endian
+#define MOZI_BYTE_ORDER MOZI_LITTLE_ENDIAN
+#endif
+#endif
+
+namespace mozi {
+
+enum class endian {
+    unknown,
+    little,
+    big,
+};
+
+// Byte order of the target platform; code that depends on the memory
+// layout of integers shall fall back to portable code when it is unknown.
+inline constexpr endian native_endian =
+#if MOZI_BYTE_ORDER == MOZI_LITTLE_ENDIAN
+    endian::little;
+#elif MOZI_BYTE_ORDER == MOZI_BIG_ENDIAN
+    endian::big;
+#else
+    endian::unknown;
+#endif
+
+template <typename T>
+constexpr T byte_swap(T value)
+{
+    static_assert(std::is_unsigned_v<T>,
+                  "Only unsigned integers can be byte-swapped");
+#if defined(__GNUC__)
+    if constexpr (sizeof(T) == 2) {
+        return __builtin_bswap16(value);
+    } else if constexpr (sizeof(T) == 4) {
+        return __builtin_bswap32(value);
+    } else if constexpr (sizeof(T) == 8) {
+        return __builtin_bswap64(value);
+    } else
+#endif
+    {
+        T result{};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            result = static_cast<T>(result << CHAR_BIT);
+            result |= static_cast<T>(value & static_cast<T>(UCHAR_MAX));
+            value = static_cast<T>(value >> CHAR_BIT);
+        }
+        return result;
+    }
+}
+
+} // namespace mozi
+
+#endif // MOZI_ENDIAN_HPP
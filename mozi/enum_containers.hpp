@@ -0,0 +1,339 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_ENUM_CONTAINERS_HPP
+#define MOZI_ENUM_CONTAINERS_HPP
+
+// Dense containers keyed by reflected enums.  Each distinct enumerator
+// value gets an index (its rank when the values are sorted), which is
+// computed at compile time for constant keys and in constant time for
+// dense enums.
+
+#include <array>                    // std::array
+#include <climits>                  // CHAR_BIT
+#include <cstddef>                  // std::size_t/ptrdiff_t
+#include <cstdint>                  // std::uint64_t
+#include <initializer_list>         // std::initializer_list
+#include <iterator>                 // std::forward_iterator_tag
+#include <stdexcept>                // std::out_of_range
+#include "bit_ops.hpp"              // mozi::countr_zero/popcount
+#include "enum_reflection_core.hpp" // mozi::detail::enum_tables/...
+#include "type_traits.hpp"          // mozi::is_reflected_enum
+
+namespace mozi {
+
+namespace detail {
+
+template <typename Enum>
+constexpr std::size_t enum_index(Enum value)
+{
+    return enum_tables<Enum>::find_index(to_underlying(value));
+}
+
+} // namespace detail
+
+// Array with an element for each value of a reflected enum
+template <typename Enum, typename T>
+class enum_array {
+public:
+    static_assert(is_reflected_enum_v<Enum>, "Enum must be reflected");
+
+    using key_type = Enum;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator =
+        typename std::array<T, detail::enum_tables<Enum>::value_count>::
+            iterator;
+    using const_iterator =
+        typename std::array<T, detail::enum_tables<Enum>::value_count>::
+            const_iterator;
+
+    // The value must be defined
+    constexpr T& operator[](Enum key)
+    {
+        return elements_[detail::enum_index(key)];
+    }
+    constexpr const T& operator[](Enum key) const
+    {
+        return elements_[detail::enum_index(key)];
+    }
+
+    constexpr T& at(Enum key)
+    {
+        return elements_[checked_index(key)];
+    }
+    constexpr const T& at(Enum key) const
+    {
+        return elements_[checked_index(key)];
+    }
+
+    // Returns the key of the element at an index
+    static constexpr Enum key(size_type index)
+    {
+        return enum_values<Enum>()[index];
+    }
+
+    static constexpr size_type size() noexcept
+    {
+        return detail::enum_tables<Enum>::value_count;
+    }
+
+    constexpr T* data() noexcept
+    {
+        return elements_.data();
+    }
+    constexpr const T* data() const noexcept
+    {
+        return elements_.data();
+    }
+
+    constexpr iterator begin() noexcept
+    {
+        return elements_.begin();
+    }
+    constexpr const_iterator begin() const noexcept
+    {
+        return elements_.begin();
+    }
+    constexpr iterator end() noexcept
+    {
+        return elements_.end();
+    }
+    constexpr const_iterator end() const noexcept
+    {
+        return elements_.end();
+    }
+
+    constexpr void fill(const T& value)
+    {
+        for (auto& element : elements_) {
+            element = value;
+        }
+    }
+
+private:
+    static constexpr size_type checked_index(Enum key)
+    {
+        auto index = detail::enum_index(key);
+        if (index == size()) {
+            throw std::out_of_range("Undefined enum value");
+        }
+        return index;
+    }
+
+    std::array<T, detail::enum_tables<Enum>::value_count> elements_{};
+};
+
+// Set of values of a reflected enum, stored as a bitset
+template <typename Enum>
+class enum_set {
+public:
+    static_assert(is_reflected_enum_v<Enum>, "Enum must be reflected");
+
+    using key_type = Enum;
+    using value_type = Enum;
+    using size_type = std::size_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Enum;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Enum*;
+        using reference = Enum;
+
+        constexpr const_iterator() = default;
+        constexpr const_iterator(const enum_set* set, size_type index)
+            : set_(set), index_(index)
+        {
+        }
+
+        constexpr Enum operator*() const
+        {
+            return enum_values<Enum>()[index_];
+        }
+        constexpr const_iterator& operator++()
+        {
+            index_ = set_->find_next(index_ + 1);
+            return *this;
+        }
+        constexpr const_iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+        friend constexpr bool operator==(const const_iterator& lhs,
+                                         const const_iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+        friend constexpr bool operator!=(const const_iterator& lhs,
+                                         const const_iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        const enum_set* set_{};
+        size_type index_{};
+    };
+    using iterator = const_iterator;
+
+    constexpr enum_set() = default;
+    constexpr enum_set(std::initializer_list<Enum> keys)
+    {
+        for (auto key : keys) {
+            insert(key);
+        }
+    }
+
+    // Undefined values are ignored
+    constexpr void insert(Enum key)
+    {
+        auto index = detail::enum_index(key);
+        if (index != max_size()) {
+            words_[index / word_bits] |=
+                word_type{1} << (index % word_bits);
+        }
+    }
+    constexpr void erase(Enum key)
+    {
+        auto index = detail::enum_index(key);
+        if (index != max_size()) {
+            words_[index / word_bits] &=
+                ~(word_type{1} << (index % word_bits));
+        }
+    }
+    constexpr bool contains(Enum key) const
+    {
+        auto index = detail::enum_index(key);
+        return index != max_size() &&
+               ((words_[index / word_bits] >> (index % word_bits)) & 1U) !=
+                   0;
+    }
+    constexpr void clear() noexcept
+    {
+        for (auto& word : words_) {
+            word = 0;
+        }
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        size_type result = 0;
+        for (auto word : words_) {
+            result += static_cast<size_type>(popcount(word));
+        }
+        return result;
+    }
+    constexpr bool empty() const noexcept
+    {
+        for (auto word : words_) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static constexpr size_type max_size() noexcept
+    {
+        return detail::enum_tables<Enum>::value_count;
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return const_iterator(this, find_next(0));
+    }
+    constexpr const_iterator end() const
+    {
+        return const_iterator(this, max_size());
+    }
+
+    constexpr enum_set& operator|=(const enum_set& rhs)
+    {
+        for (size_type i = 0; i < word_count; ++i) {
+            words_[i] |= rhs.words_[i];
+        }
+        return *this;
+    }
+    constexpr enum_set& operator&=(const enum_set& rhs)
+    {
+        for (size_type i = 0; i < word_count; ++i) {
+            words_[i] &= rhs.words_[i];
+        }
+        return *this;
+    }
+    friend constexpr enum_set operator|(enum_set lhs, const enum_set& rhs)
+    {
+        return lhs |= rhs;
+    }
+    friend constexpr enum_set operator&(enum_set lhs, const enum_set& rhs)
+    {
+        return lhs &= rhs;
+    }
+    friend constexpr bool operator==(const enum_set& lhs,
+                                     const enum_set& rhs)
+    {
+        for (size_type i = 0; i < word_count; ++i) {
+            if (lhs.words_[i] != rhs.words_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend constexpr bool operator!=(const enum_set& lhs,
+                                     const enum_set& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    using word_type = std::uint64_t;
+    static constexpr size_type word_bits = sizeof(word_type) * CHAR_BIT;
+    static constexpr size_type word_count =
+        (max_size() + word_bits - 1) / word_bits;
+
+    // Returns the index of the first value in the set at or after an
+    // index, or max_size() if there is none
+    constexpr size_type find_next(size_type index) const
+    {
+        while (index < max_size()) {
+            auto word = words_[index / word_bits] >> (index % word_bits);
+            if (word != 0) {
+                return index + static_cast<size_type>(countr_zero(word));
+            }
+            index = (index / word_bits + 1) * word_bits;
+        }
+        return max_size();
+    }
+
+    std::array<word_type, word_count> words_{};
+};
+
+} // namespace mozi
+
+#endif // MOZI_ENUM_CONTAINERS_HPP
@@ -24,7 +24,9 @@
 #ifndef MOZI_ENUM_REFLECTION_HPP
 #define MOZI_ENUM_REFLECTION_HPP
 
+#include "enum_reflection_compat.hpp" // IWYU pragma: export
 #include "enum_reflection_core.hpp"  // IWYU pragma: export
+#include "enum_reflection_flags.hpp" // IWYU pragma: export
 #include "enum_reflection_print.hpp" // IWYU pragma: export
 
 #endif // MOZI_ENUM_REFLECTION_HPP
@@ -0,0 +1,88 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_ENUM_REFLECTION_COMPAT_HPP
+#define MOZI_ENUM_REFLECTION_COMPAT_HPP
+
+#include <algorithm>                // std::sort/stable_sort/unique
+#include <type_traits>              // std::decay/underlying_type
+#include <vector>                   // std::vector
+#include "enum_reflection_core.hpp" // mozi::detail::enum_value_name_pair
+
+// The run-time sorted maps below predate enum_tables, which provides the
+// same tables at compile time.  They are kept only for existing code.
+
+namespace mozi {
+
+namespace detail {
+
+template <typename Int, typename Iterator>
+auto sort_uniq_first(Iterator first, Iterator last)
+{
+    std::vector<std::decay_t<decltype(*first)>> result{first, last};
+    std::stable_sort(result.begin(), result.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                         return lhs.first < rhs.first;
+                     });
+    auto end = std::unique(result.begin(), result.end(),
+                           [](const auto& lhs, const auto& rhs) {
+                               return lhs.first == rhs.first;
+                           });
+    result.erase(end, result.end());
+    return result;
+}
+
+template <typename Int, typename Iterator>
+auto sort_second(Iterator first, Iterator last)
+{
+    std::vector<std::decay_t<decltype(*first)>> result{first, last};
+    std::sort(result.begin(), result.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.second < rhs.second;
+              });
+    return result;
+}
+
+} // namespace detail
+
+template <typename Enum, typename Iterator>
+[[deprecated("Use enum_tables instead")]] const std::vector<
+    detail::enum_value_name_pair<std::underlying_type_t<Enum>>>&
+get_enum_value_name_map(Iterator first, Iterator last)
+{
+    static auto result =
+        detail::sort_uniq_first<std::underlying_type_t<Enum>>(first, last);
+    return result;
+}
+
+template <typename Enum, typename Iterator>
+[[deprecated("Use enum_tables instead")]] const std::vector<
+    detail::enum_value_name_pair<std::underlying_type_t<Enum>>>&
+get_enum_name_value_map(Iterator first, Iterator last)
+{
+    static auto result =
+        detail::sort_second<std::underlying_type_t<Enum>>(first, last);
+    return result;
+}
+
+} // namespace mozi
+
+#endif // MOZI_ENUM_REFLECTION_COMPAT_HPP
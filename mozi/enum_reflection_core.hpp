@@ -24,20 +24,27 @@
 #ifndef MOZI_ENUM_REFLECTION_CORE_HPP
 #define MOZI_ENUM_REFLECTION_CORE_HPP
 
-#include <algorithm>   // std::lower_bound/sort/stable_sort/unique
 #include <array>       // IWYU pragma: keep std::array
+#include <charconv>    // std::to_chars
 #include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint8_t/uint16_t/uint64_t/UINT8_MAX/...
+#include <limits>      // std::numeric_limits
 #include <string>      // std::string
 #include <string_view> // std::string_view
-#include <type_traits> // std::decay/underlying_type/void_t/...
-#include <utility>     // std::pair
-#include <vector>      // std::vector
+#include <type_traits> // std::integral_constant/invoke_result/...
+#include <utility>     // std::pair/index_sequence
 #include "metamacro.h" // MOZI_GET_ARG_COUNT/MOZI_REPEAT_FIRST_ON
 
 namespace mozi {
 
 enum class enum_to_string { no_show_name, show_name };
 
+template <typename Enum>
+constexpr std::underlying_type_t<Enum> to_underlying(Enum e) noexcept
+{
+    return static_cast<std::underlying_type_t<Enum>>(e);
+}
+
 namespace detail {
 
 template <typename Enum>
@@ -63,42 +70,6 @@ private:
 template <typename Int>
 using enum_value_name_pair = std::pair<Int, std::string_view>;
 
-template <typename Int>
-struct enum_value_comparator {
-    bool operator()(const enum_value_name_pair<Int>& lhs,
-                    const enum_value_name_pair<Int>& rhs) const
-    {
-        return lhs.first < rhs.first;
-    }
-    bool operator()(Int lhs, const enum_value_name_pair<Int>& rhs) const
-    {
-        return lhs < rhs.first;
-    }
-    bool operator()(const enum_value_name_pair<Int>& lhs, Int rhs) const
-    {
-        return lhs.first < rhs;
-    }
-};
-
-template <typename Int>
-struct enum_name_comparator {
-    bool operator()(const enum_value_name_pair<Int>& lhs,
-                    const enum_value_name_pair<Int>& rhs) const
-    {
-        return lhs.second < rhs.second;
-    }
-    bool operator()(std::string_view lhs,
-                    const enum_value_name_pair<Int>& rhs) const
-    {
-        return lhs < rhs.second;
-    }
-    bool operator()(const enum_value_name_pair<Int>& lhs,
-                    std::string_view rhs) const
-    {
-        return lhs.second < rhs;
-    }
-};
-
 // NOLINTNEXTLINE(bugprone-exception-escape)
 constexpr std::string_view remove_equals(std::string_view s) noexcept
 {
@@ -112,105 +83,558 @@ constexpr std::string_view remove_equals(std::string_view s) noexcept
     return s;
 }
 
-template <typename Int, typename Iterator>
-auto sort_uniq_first(Iterator first, Iterator last)
+// Indices of the items of an enum map, stably sorted with a comparison
+// function.  Only integers are assigned during sorting, as assignment of
+// std::pair is not constexpr before C++20.
+template <typename Int, std::size_t N, typename Compare>
+constexpr std::array<std::size_t, N>
+get_sorted_indices(const std::array<enum_value_name_pair<Int>, N>& map,
+                   Compare compare)
 {
-    std::vector<std::decay_t<decltype(*first)>> result{first, last};
-    std::stable_sort(result.begin(), result.end(),
-                     [](const auto& lhs, const auto& rhs) {
-                         return lhs.first < rhs.first;
-                     });
-    auto end = std::unique(result.begin(), result.end(),
-                           [](const auto& lhs, const auto& rhs) {
-                               return lhs.first == rhs.first;
-                           });
-    result.erase(end, result.end());
+    std::array<std::size_t, N> result{};
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = i;
+    }
+    for (std::size_t i = 1; i < N; ++i) {
+        auto index = result[i];
+        auto j = i;
+        for (; j > 0 && compare(map[index], map[result[j - 1]]); --j) {
+            result[j] = result[j - 1];
+        }
+        result[j] = index;
+    }
     return result;
 }
 
-template <typename Int, typename Iterator>
-auto sort_second(Iterator first, Iterator last)
+template <typename Int, std::size_t N>
+constexpr std::size_t
+count_unique_values(const std::array<enum_value_name_pair<Int>, N>& map,
+                    const std::array<std::size_t, N>& sorted_indices)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i == 0 || map[sorted_indices[i]].first !=
+                          map[sorted_indices[i - 1]].first) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+// Indices of the first items of the runs of equal values
+template <std::size_t M, typename Int, std::size_t N>
+constexpr std::array<std::size_t, M> get_unique_value_indices(
+    const std::array<enum_value_name_pair<Int>, N>& map,
+    const std::array<std::size_t, N>& sorted_indices)
+{
+    std::array<std::size_t, M> result{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i == 0 || map[sorted_indices[i]].first !=
+                          map[sorted_indices[i - 1]].first) {
+            result[count++] = sorted_indices[i];
+        }
+    }
+    return result;
+}
+
+template <typename Int, std::size_t N, std::size_t M, std::size_t... Is>
+constexpr std::array<enum_value_name_pair<Int>, M>
+make_enum_table(const std::array<enum_value_name_pair<Int>, N>& map,
+                const std::array<std::size_t, M>& indices,
+                std::index_sequence<Is...>)
+{
+    return {map[indices[Is]]...};
+}
+
+constexpr std::size_t bit_ceil(std::size_t value)
 {
-    std::vector<std::decay_t<decltype(*first)>> result{first, last};
-    std::sort(result.begin(), result.end(),
-              [](const auto& lhs, const auto& rhs) {
-                  return lhs.second < rhs.second;
-              });
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
     return result;
 }
 
-template <typename Int, typename Iterator>
-Iterator find_enum_value(Int value, Iterator first, Iterator last)
+// FNV-1a hash of an enumerator name
+constexpr std::uint64_t hash_enum_name(std::string_view name)
 {
-    enum_value_comparator<Int> compare;
-    Iterator it = std::lower_bound(first, last, value, compare);
-    if (it != last && !compare(value, *it)) {
-        return it;
+    std::uint64_t result = 0xcbf29ce484222325;
+    for (char ch : name) {
+        result ^= static_cast<unsigned char>(ch);
+        result *= 0x100000001b3;
     }
-    return last;
+    return result;
+}
+
+// Mixes a name hash with the displacement of its bucket (using the
+// finalizer of MurmurHash3)
+constexpr std::uint64_t mix_enum_name_hash(std::uint64_t hash,
+                                           std::uint32_t displacement)
+{
+    auto result = hash ^ (displacement * 0x9e3779b97f4a7c15);
+    result ^= result >> 33;
+    result *= 0xff51afd7ed558ccd;
+    result ^= result >> 33;
+    return result;
 }
 
-template <typename Int, typename Iterator>
-std::string to_string_impl(Int value, const char* enum_name,
-                           enum_to_string flag, Iterator first,
-                           Iterator last)
+// Perfect hash table of enumerator names, using hash and displace: the
+// names are grouped into buckets by their hashes, and each bucket gets a
+// displacement that moves all its names into free slots.  Looking up a
+// name takes one hash calculation and one string comparison.
+template <typename Index, std::size_t BucketCount, std::size_t SlotCount>
+struct enum_name_hash_table {
+    static constexpr std::uint32_t max_displacement = 1U << 16;
+
+    static constexpr std::size_t get_bucket(std::uint64_t hash)
+    {
+        return static_cast<std::size_t>(hash >> 32) & (BucketCount - 1);
+    }
+    constexpr std::size_t get_slot(std::uint64_t hash) const
+    {
+        return static_cast<std::size_t>(mix_enum_name_hash(
+                   hash, displacements[get_bucket(hash)])) &
+               (SlotCount - 1);
+    }
+
+    // Whether the table is built successfully
+    bool valid;
+    std::array<std::uint32_t, BucketCount> displacements;
+    // Indices of the names plus one, where 0 means an empty slot
+    std::array<Index, SlotCount> slots;
+};
+
+template <typename Index, std::size_t BucketCount, std::size_t SlotCount,
+          typename Int, std::size_t N>
+constexpr enum_name_hash_table<Index, BucketCount, SlotCount>
+make_enum_name_hash_table(
+    const std::array<enum_value_name_pair<Int>, N>& names)
 {
-    std::string result;
-    auto it = find_enum_value(value, first, last);
-    if (it != last) {
-        if (flag == enum_to_string::show_name) {
-            result = enum_name;
-            result += "::";
+    using table_type = enum_name_hash_table<Index, BucketCount, SlotCount>;
+    table_type result{};
+
+    // Group the names by buckets
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, BucketCount + 1> bucket_starts{};
+    for (std::size_t i = 0; i < N; ++i) {
+        hashes[i] = hash_enum_name(names[i].second);
+        ++bucket_starts[table_type::get_bucket(hashes[i]) + 1];
+    }
+    for (std::size_t i = 0; i < BucketCount; ++i) {
+        bucket_starts[i + 1] += bucket_starts[i];
+    }
+    std::array<std::size_t, N> members{};
+    std::array<std::size_t, BucketCount> member_counts{};
+    for (std::size_t i = 0; i < N; ++i) {
+        auto bucket = table_type::get_bucket(hashes[i]);
+        members[bucket_starts[bucket] + member_counts[bucket]++] = i;
+    }
+
+    // Place the larger buckets first
+    std::array<std::size_t, BucketCount> bucket_order{};
+    for (std::size_t i = 0; i < BucketCount; ++i) {
+        auto j = i;
+        for (; j > 0 && member_counts[bucket_order[j - 1]] <
+                            member_counts[i];
+             --j) {
+            bucket_order[j] = bucket_order[j - 1];
         }
-        result += it->second;
-    } else {
-        result = "(";
-        result += enum_name;
-        result += ")";
-        result += std::to_string(value);
+        bucket_order[j] = i;
     }
+
+    for (auto bucket : bucket_order) {
+        auto first = bucket_starts[bucket];
+        auto last = bucket_starts[bucket + 1];
+        if (first == last) {
+            break;
+        }
+        for (std::uint32_t d = 0;; ++d) {
+            if (d == table_type::max_displacement) {
+                return result;
+            }
+            result.displacements[bucket] = d;
+            auto i = first;
+            for (; i < last; ++i) {
+                auto slot = result.get_slot(hashes[members[i]]);
+                if (result.slots[slot] != 0) {
+                    break;
+                }
+                result.slots[slot] = static_cast<Index>(members[i] + 1);
+            }
+            if (i == last) {
+                break;
+            }
+            // Undo the placement of this bucket
+            while (i > first) {
+                --i;
+                result.slots[result.get_slot(hashes[members[i]])] = 0;
+            }
+        }
+    }
+    result.valid = true;
     return result;
 }
 
-template <typename Enum, typename Iterator>
-bool from_string_impl(std::string_view name, Enum& value, Iterator first,
-                      Iterator last)
+// Compile-time lookup tables of a reflected enum, built from the enum map
+// generated by MOZI_DEFINE_ENUM/MOZI_DEFINE_ENUM_CLASS.  The value table
+// is sorted by value and keeps only the first name of each value; the
+// name table is sorted by name.
+template <typename Enum>
+struct enum_tables {
+    using underlying_type = std::underlying_type_t<Enum>;
+    using value_type = enum_value_name_pair<underlying_type>;
+
+    static constexpr const auto& map = mozi_enum_map(Enum{});
+    static constexpr std::size_t size = map.size();
+
+    static constexpr auto sorted_value_indices =
+        get_sorted_indices(map, [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+    static constexpr std::size_t value_count =
+        count_unique_values(map, sorted_value_indices);
+    static constexpr std::array<value_type, value_count> values =
+        make_enum_table(map,
+                        get_unique_value_indices<value_count>(
+                            map, sorted_value_indices),
+                        std::make_index_sequence<value_count>{});
+
+    static constexpr std::array<value_type, size> names = make_enum_table(
+        map,
+        get_sorted_indices(map,
+                           [](const auto& lhs, const auto& rhs) {
+                               return lhs.second < rhs.second;
+                           }),
+        std::make_index_sequence<size>{});
+
+    // The distinct values as enumerators, sorted
+    static constexpr auto enumerators = [] {
+        std::array<Enum, value_count> result{};
+        for (std::size_t i = 0; i < value_count; ++i) {
+            result[i] = static_cast<Enum>(values[i].first);
+        }
+        return result;
+    }();
+
+    static constexpr underlying_type min_value = values.front().first;
+    static constexpr underlying_type max_value = values.back().first;
+
+    // Distance of a value from the minimum value, calculated with
+    // wrap-around so that values less than the minimum are out of range
+    static constexpr std::uint64_t offset_of(underlying_type value)
+    {
+        return static_cast<std::uint64_t>(value) -
+               static_cast<std::uint64_t>(min_value);
+    }
+
+    // Offset of the maximum value.  The number of values in the range,
+    // max_offset + 1, would wrap to zero for a range covering all 64-bit
+    // values, so checks are done on max_offset instead.
+    static constexpr std::uint64_t max_offset = offset_of(max_value);
+
+    // The values are dense when no more than about half of the entries of
+    // a direct lookup table would be unused; then to_string and is_defined
+    // index the table instead of doing a binary search.
+    static constexpr bool is_dense = max_offset < 2 * value_count + 8;
+
+    // Type of indices into the tables, plus one
+    using index_type = std::conditional_t<
+        (size < UINT8_MAX), std::uint8_t,
+        std::conditional_t<(size < UINT16_MAX), std::uint16_t,
+                           std::size_t>>;
+
+    // Indices into values plus one, where 0 means undefined
+    static constexpr auto dense_table = [] {
+        std::array<index_type,
+                   is_dense ? static_cast<std::size_t>(max_offset + 1)
+                            : 0>
+            result{};
+        if constexpr (is_dense) {
+            for (std::size_t i = 0; i < value_count; ++i) {
+                result[static_cast<std::size_t>(
+                    offset_of(values[i].first))] =
+                    static_cast<index_type>(i + 1);
+            }
+        }
+        return result;
+    }();
+
+    // Returns the index of a value in the value table, or value_count if
+    // it is not defined
+    static constexpr std::size_t find_index(underlying_type value)
+    {
+        if constexpr (is_dense) {
+            auto offset = offset_of(value);
+            if (offset > max_offset) {
+                return value_count;
+            }
+            auto index = dense_table[static_cast<std::size_t>(offset)];
+            return index == 0 ? value_count : index - 1U;
+        }
+        std::size_t first = 0;
+        std::size_t last = value_count;
+        while (first < last) {
+            auto mid = first + (last - first) / 2;
+            if (values[mid].first < value) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        if (first != value_count && values[first].first == value) {
+            return first;
+        }
+        return value_count;
+    }
+
+    // Bitmap of the defined values by offset, used by is_defined when the
+    // values are not contiguous but a bitmap needs no more than about
+    // eight bytes per value
+    static constexpr bool is_contiguous = max_offset == value_count - 1;
+    static constexpr bool has_value_bitmap =
+        !is_contiguous && max_offset < 64 * (value_count + 1);
+    static constexpr auto value_bitmap = [] {
+        std::array<std::uint64_t,
+                   has_value_bitmap
+                       ? static_cast<std::size_t>(max_offset / 64 + 1)
+                       : 0>
+            result{};
+        if constexpr (has_value_bitmap) {
+            for (const auto& item : values) {
+                auto offset = offset_of(item.first);
+                result[static_cast<std::size_t>(offset / 64)] |=
+                    std::uint64_t{1} << (offset % 64);
+            }
+        }
+        return result;
+    }();
+
+    // Checks whether a value is defined with a range check or a bitmap
+    // test, falling back to find_index for sparse values
+    static constexpr bool is_defined(underlying_type value)
+    {
+        if constexpr (is_contiguous) {
+            return offset_of(value) <= max_offset;
+        } else if constexpr (has_value_bitmap) {
+            auto offset = offset_of(value);
+            return offset <= max_offset &&
+                   ((value_bitmap[static_cast<std::size_t>(offset / 64)] >>
+                     (offset % 64)) &
+                    1U) != 0;
+        } else {
+            return find_index(value) != value_count;
+        }
+    }
+
+    // Returns the item for a value, or nullptr if it is not defined
+    static constexpr const value_type* find_value(underlying_type value)
+    {
+        auto index = find_index(value);
+        return index == value_count ? nullptr : &values[index];
+    }
+
+    static constexpr std::string_view enum_name = mozi_enum_name(Enum{});
+
+    // Qualified names, like "Enum::name", of the values, stored back to
+    // back
+    static constexpr auto qualified_name_offsets = [] {
+        std::array<std::size_t, value_count + 1> result{};
+        for (std::size_t i = 0; i < value_count; ++i) {
+            result[i + 1] = result[i] + enum_name.size() + 2 +
+                            values[i].second.size();
+        }
+        return result;
+    }();
+    static constexpr auto qualified_name_chars = [] {
+        std::array<char, qualified_name_offsets[value_count]> result{};
+        std::size_t pos = 0;
+        for (const auto& item : values) {
+            for (char ch : enum_name) {
+                result[pos++] = ch;
+            }
+            result[pos++] = ':';
+            result[pos++] = ':';
+            for (char ch : item.second) {
+                result[pos++] = ch;
+            }
+        }
+        return result;
+    }();
+
+    // Returns the qualified name of an item in the value table
+    static constexpr std::string_view qualified_name(const value_type* item)
+    {
+        auto index = static_cast<std::size_t>(item - values.data());
+        return {qualified_name_chars.data() + qualified_name_offsets[index],
+                qualified_name_offsets[index + 1] -
+                    qualified_name_offsets[index]};
+    }
+
+    static constexpr auto name_hash_table =
+        make_enum_name_hash_table<index_type, bit_ceil((size + 3) / 4),
+                                  bit_ceil(size * 2)>(names);
+
+    // Returns the item for a name, or nullptr if it is not found
+    static constexpr const value_type* find_name(std::string_view name)
+    {
+        if constexpr (name_hash_table.valid) {
+            auto slot = name_hash_table.get_slot(hash_enum_name(name));
+            auto index = name_hash_table.slots[slot];
+            if (index != 0 && names[index - 1U].second == name) {
+                return &names[index - 1U];
+            }
+            return nullptr;
+        }
+        std::size_t first = 0;
+        std::size_t last = size;
+        while (first < last) {
+            auto mid = first + (last - first) / 2;
+            if (names[mid].second < name) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        if (first != size && names[first].second == name) {
+            return &names[first];
+        }
+        return nullptr;
+    }
+};
+
+template <typename Enum>
+constexpr std::string_view to_string_view_impl(Enum value,
+                                               enum_to_string flag)
 {
-    enum_name_comparator<std::underlying_type_t<Enum>> compare;
-    auto it = std::lower_bound(first, last, name, compare);
-    if (it != last && !compare(name, *it)) {
-        value = Enum{it->first};
+    using tables = enum_tables<Enum>;
+    auto item = tables::find_value(to_underlying(value));
+    if (!item) {
+        return {};
+    }
+    if (flag == enum_to_string::show_name) {
+        return tables::qualified_name(item);
+    }
+    return item->second;
+}
+
+// Appends the string form of an undefined value, like "(Enum)42"
+template <typename Enum>
+void append_undefined_enum(Enum value, std::string& dest)
+{
+    using int_type =
+        std::conditional_t<std::is_signed_v<std::underlying_type_t<Enum>>,
+                           long long, unsigned long long>;
+    std::array<char, std::numeric_limits<int_type>::digits10 + 3> buffer{};
+    auto result =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                      static_cast<int_type>(to_underlying(value)));
+    dest += '(';
+    dest += enum_tables<Enum>::enum_name;
+    dest += ')';
+    dest.append(buffer.data(), result.ptr);
+}
+
+template <typename Enum>
+void to_string_impl(Enum value, std::string& dest, enum_to_string flag)
+{
+    auto name = to_string_view_impl(value, flag);
+    if (!name.empty()) {
+        dest += name;
+    } else {
+        append_undefined_enum(value, dest);
+    }
+}
+
+template <typename Enum>
+constexpr bool from_string_impl(std::string_view name, Enum& value)
+{
+    auto item = enum_tables<Enum>::find_name(name);
+    if (item) {
+        value = Enum{item->first};
         return true;
     }
     return false;
 }
 
+template <typename Enum, typename Visitor>
+using enum_switch_result_t = std::invoke_result_t<
+    Visitor&,
+    std::integral_constant<Enum, enum_tables<Enum>::enumerators[0]>>;
+
+// Calls the visitor with the value as an std::integral_constant through a
+// table of function pointers indexed by the position of the value in the
+// value table, or the default visitor with the value if it is undefined
+template <typename Enum, typename Visitor, typename Default,
+          std::size_t... Is>
+constexpr enum_switch_result_t<Enum, Visitor>
+enum_switch_impl(Enum value, Visitor& visitor, Default& default_visitor,
+                 std::index_sequence<Is...>)
+{
+    using tables = enum_tables<Enum>;
+    using result_type = enum_switch_result_t<Enum, Visitor>;
+    using handler_type = result_type (*)(Visitor&);
+    constexpr handler_type handlers[] = {
+        [](Visitor& v) -> result_type {
+            return v(std::integral_constant<Enum,
+                                            tables::enumerators[Is]>{});
+        }...};
+    auto index = tables::find_index(to_underlying(value));
+    if (index == tables::value_count) {
+        return default_visitor(value);
+    }
+    return handlers[index](visitor);
+}
+
 } // namespace detail
 
-template <typename Enum, typename Iterator>
-const std::vector<
-    detail::enum_value_name_pair<std::underlying_type_t<Enum>>>&
-get_enum_value_name_map(Iterator first, Iterator last)
+// Returns the distinct values of a reflected enum in ascending order
+template <typename Enum>
+constexpr const auto& enum_values() noexcept
 {
-    static auto result =
-        detail::sort_uniq_first<std::underlying_type_t<Enum>>(first, last);
-    return result;
+    return detail::enum_tables<Enum>::enumerators;
 }
 
-template <typename Enum, typename Iterator>
-const std::vector<
-    detail::enum_value_name_pair<std::underlying_type_t<Enum>>>&
-get_enum_name_value_map(Iterator first, Iterator last)
+// Returns the number of distinct values of a reflected enum
+template <typename Enum>
+constexpr std::size_t enum_count() noexcept
 {
-    static auto result =
-        detail::sort_second<std::underlying_type_t<Enum>>(first, last);
-    return result;
+    return detail::enum_tables<Enum>::value_count;
 }
 
 template <typename Enum>
-constexpr std::underlying_type_t<Enum> to_underlying(Enum e) noexcept
+constexpr Enum enum_min() noexcept
 {
-    return static_cast<std::underlying_type_t<Enum>>(e);
+    return static_cast<Enum>(detail::enum_tables<Enum>::min_value);
+}
+
+template <typename Enum>
+constexpr Enum enum_max() noexcept
+{
+    return static_cast<Enum>(detail::enum_tables<Enum>::max_value);
+}
+
+// Calls visitor(std::integral_constant<Enum, value>{}) for a defined
+// value, or default_visitor(value) otherwise.  All calls must return the
+// same type.
+template <typename Enum, typename Visitor, typename Default>
+constexpr decltype(auto) enum_switch(Enum value, Visitor&& visitor,
+                                     Default&& default_visitor)
+{
+    static_assert(enum_count<Enum>() > 0, "Enum must have enumerators");
+    return detail::enum_switch_impl(
+        value, visitor, default_visitor,
+        std::make_index_sequence<enum_count<Enum>()>{});
+}
+
+// Calls visitor(std::integral_constant<Enum, value>{}) for a defined
+// value; an undefined value gives a value-initialized result
+template <typename Enum, typename Visitor>
+constexpr decltype(auto) enum_switch(Enum value, Visitor&& visitor)
+{
+    using result_type = detail::enum_switch_result_t<Enum, Visitor>;
+    return enum_switch(value, visitor,
+                       [](Enum) { return result_type(); });
 }
 
 } // namespace mozi
@@ -236,36 +660,52 @@ constexpr std::underlying_type_t<Enum> to_underlying(Enum e) noexcept
                   e((mozi::detail::eat_assign<e>)e::arg /* NOLINT */)),    \
               mozi::detail::remove_equals(#arg)},
 
+#define MOZI_ENUM_HOOKS(e)                                                 \
+    constexpr const auto& mozi_enum_map(e) /* for enum_tables only */      \
+    {                                                                      \
+        return e##_enum_map_;                                              \
+    }                                                                      \
+    constexpr std::string_view mozi_enum_name(e) /* ditto */               \
+    {                                                                      \
+        return #e;                                                         \
+    }                                                                      \
+    MOZI_DIAGNOSTIC_PUSH                                                   \
+    MOZI_DISABLE_UNUSED_FUNC_WARNING                                       \
+    bool is_mozi_reflected_enum(e) /* for is_reflected_enum only */;       \
+    MOZI_DIAGNOSTIC_POP
+
 #define MOZI_ENUM_FUNCTIONS(e, u)                                          \
-    inline bool is_defined(e value)                                        \
+    MOZI_ENUM_HOOKS(e)                                                     \
+    inline constexpr bool is_defined(e value)                              \
     {                                                                      \
-        const auto& value_name_map = mozi::get_enum_value_name_map<e>(     \
-            e##_enum_map_.begin(), e##_enum_map_.end());                   \
-        return mozi::detail::find_enum_value(                              \
-                   mozi::to_underlying(value), value_name_map.begin(),     \
-                   value_name_map.end()) != value_name_map.end();          \
+        return mozi::detail::enum_tables<e>::is_defined(                   \
+            mozi::to_underlying(value));                                   \
+    }                                                                      \
+    inline constexpr std::string_view to_string_view(                      \
+        e value,                                                           \
+        mozi::enum_to_string flag = mozi::enum_to_string::no_show_name)    \
+    {                                                                      \
+        return mozi::detail::to_string_view_impl(value, flag);             \
+    }                                                                      \
+    inline void to_string(e value, std::string& dest,                      \
+                          mozi::enum_to_string flag =                      \
+                              mozi::enum_to_string::no_show_name)          \
+    {                                                                      \
+        mozi::detail::to_string_impl(value, dest, flag);                   \
     }                                                                      \
     inline std::string to_string(e value,                                  \
                                  mozi::enum_to_string flag =               \
                                      mozi::enum_to_string::no_show_name)   \
     {                                                                      \
-        const auto& value_name_map = mozi::get_enum_value_name_map<e>(     \
-            e##_enum_map_.begin(), e##_enum_map_.end());                   \
-        return mozi::detail::to_string_impl(                               \
-            mozi::to_underlying(value), #e, flag, value_name_map.begin(),  \
-            value_name_map.end());                                         \
+        std::string result;                                                \
+        mozi::detail::to_string_impl(value, result, flag);                 \
+        return result;                                                     \
     }                                                                      \
-    inline bool from_string(std::string_view name, e& value) /* NOLINT */  \
+    inline constexpr bool from_string(std::string_view name,               \
+                                      e& value) /* NOLINT */               \
     {                                                                      \
-        const auto& name_value_map = mozi::get_enum_name_value_map<e>(     \
-            e##_enum_map_.begin(), e##_enum_map_.end());                   \
-        return mozi::detail::from_string_impl(                             \
-            name, value, name_value_map.begin(), name_value_map.end());    \
-    }                                                                      \
-    MOZI_DIAGNOSTIC_PUSH                                                   \
-    MOZI_DISABLE_UNUSED_FUNC_WARNING                                       \
-    bool is_mozi_reflected_enum(e) /* for is_reflected_enum only */;       \
-    MOZI_DIAGNOSTIC_POP
+        return mozi::detail::from_string_impl(name, value);                \
+    }
 
 #define MOZI_DEFINE_ENUM(e, u, ...)                                        \
     enum e : u { __VA_ARGS__ };                                            \
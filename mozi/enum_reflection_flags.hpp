@@ -0,0 +1,237 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_ENUM_REFLECTION_FLAGS_HPP
+#define MOZI_ENUM_REFLECTION_FLAGS_HPP
+
+#include <array>                    // std::array
+#include <climits>                  // CHAR_BIT
+#include <cstddef>                  // std::size_t
+#include <string>                   // std::string
+#include <string_view>              // std::string_view
+#include <type_traits>              // std::make_unsigned/underlying_type
+#include "bit_ops.hpp"              // mozi::countr_zero
+#include "enum_reflection_core.hpp" // mozi::detail::enum_tables/...
+#include "metamacro.h"              // MOZI_GET_ARG_COUNT/...
+
+namespace mozi::detail {
+
+// Tables of a reflected flags enum, where single-bit enumerators name
+// the flags.  Enumerators with multiple bits (or none) are only used when
+// they match a value exactly.
+template <typename Enum>
+struct flags_tables {
+    using tables = enum_tables<Enum>;
+    using unsigned_type =
+        std::make_unsigned_t<std::underlying_type_t<Enum>>;
+
+    static constexpr std::size_t bit_count = sizeof(Enum) * CHAR_BIT;
+
+    static constexpr bool is_single_bit(unsigned_type bits)
+    {
+        return bits != 0 && (bits & (bits - 1U)) == 0;
+    }
+
+    // Names of the flags, indexed by bit position
+    static constexpr auto bit_names = [] {
+        std::array<std::string_view, bit_count> result{};
+        for (const auto& item : tables::values) {
+            auto bits = static_cast<unsigned_type>(item.first);
+            if (is_single_bit(bits)) {
+                result[static_cast<std::size_t>(countr_zero(bits))] =
+                    item.second;
+            }
+        }
+        return result;
+    }();
+
+    static constexpr unsigned_type known_bits = [] {
+        unsigned_type result{};
+        for (const auto& item : tables::values) {
+            auto bits = static_cast<unsigned_type>(item.first);
+            if (is_single_bit(bits)) {
+                result |= bits;
+            }
+        }
+        return result;
+    }();
+
+    // A value is defined when all its bits are named flags, or when it
+    // equals an enumerator
+    static constexpr bool is_defined(Enum value)
+    {
+        auto bits = static_cast<unsigned_type>(value);
+        return (bits & ~known_bits) == 0 ||
+               tables::find_value(to_underlying(value)) != nullptr;
+    }
+};
+
+constexpr std::string_view trim_spaces(std::string_view str)
+{
+    while (!str.empty() && str.front() == ' ') {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && str.back() == ' ') {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+// Converts a flags value to a string like "A|B|C".  Set bits are walked
+// with count-trailing-zeros, and bits without a name are appended as a
+// number.
+template <typename Enum>
+void flags_to_string_impl(Enum value, std::string& dest,
+                          enum_to_string flag)
+{
+    using ftables = flags_tables<Enum>;
+    using unsigned_type = typename ftables::unsigned_type;
+    auto name = to_string_view_impl(value, flag);
+    if (!name.empty()) {
+        dest += name;
+        return;
+    }
+    auto bits = static_cast<unsigned_type>(value);
+    auto unknown_bits =
+        static_cast<unsigned_type>(bits & ~ftables::known_bits);
+    bits &= ftables::known_bits;
+    bool first = true;
+    while (bits != 0) {
+        if (!first) {
+            dest += '|';
+        }
+        first = false;
+        if (flag == enum_to_string::show_name) {
+            dest += enum_tables<Enum>::enum_name;
+            dest += "::";
+        }
+        dest += ftables::bit_names[static_cast<std::size_t>(
+            countr_zero(bits))];
+        bits &= static_cast<unsigned_type>(bits - 1U);
+    }
+    if (unknown_bits != 0 || first) {
+        if (!first) {
+            dest += '|';
+        }
+        append_undefined_enum(static_cast<Enum>(unknown_bits), dest);
+    }
+}
+
+// Parses a '|'-separated list of enumerator names, ignoring spaces around
+// the names
+template <typename Enum>
+constexpr bool flags_from_string_impl(std::string_view str, Enum& value)
+{
+    using unsigned_type = typename flags_tables<Enum>::unsigned_type;
+    unsigned_type result{};
+    for (;;) {
+        auto pos = str.find('|');
+        auto item =
+            enum_tables<Enum>::find_name(trim_spaces(str.substr(0, pos)));
+        if (!item) {
+            return false;
+        }
+        result |= static_cast<unsigned_type>(item->first);
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        str.remove_prefix(pos + 1);
+    }
+    value = static_cast<Enum>(result);
+    return true;
+}
+
+} // namespace mozi::detail
+
+#define MOZI_FLAGS_ENUM_OPERATOR(e, op)                                    \
+    constexpr e operator op(e lhs, e rhs)                                  \
+    {                                                                      \
+        using unsigned_type =                                              \
+            std::make_unsigned_t<std::underlying_type_t<e>>;               \
+        return static_cast<e>(static_cast<unsigned_type>(                  \
+            static_cast<unsigned_type>(lhs) op                             \
+            static_cast<unsigned_type>(rhs)));                             \
+    }                                                                      \
+    constexpr e& operator op##=(e& lhs, e rhs)                             \
+    {                                                                      \
+        return lhs = lhs op rhs;                                           \
+    }
+
+// Functions of a flags enum.  is_defined accepts any combination of named
+// flags, but to_string_view, which cannot allocate, only names values equal
+// to a single enumerator, and returns an empty view for other values,
+// including defined combinations like "read|exec"; to_string shall be used
+// for combinations.
+#define MOZI_FLAGS_ENUM_FUNCTIONS(e, u)                                    \
+    MOZI_ENUM_HOOKS(e)                                                     \
+    MOZI_FLAGS_ENUM_OPERATOR(e, |)                                         \
+    MOZI_FLAGS_ENUM_OPERATOR(e, &)                                         \
+    MOZI_FLAGS_ENUM_OPERATOR(e, ^)                                         \
+    constexpr e operator~(e value)                                         \
+    {                                                                      \
+        using unsigned_type =                                              \
+            std::make_unsigned_t<std::underlying_type_t<e>>;               \
+        return static_cast<e>(static_cast<unsigned_type>(                  \
+            ~static_cast<unsigned_type>(value)));                          \
+    }                                                                      \
+    inline constexpr bool is_defined(e value)                              \
+    {                                                                      \
+        return mozi::detail::flags_tables<e>::is_defined(value);           \
+    }                                                                      \
+    inline constexpr std::string_view to_string_view(                      \
+        e value,                                                           \
+        mozi::enum_to_string flag = mozi::enum_to_string::no_show_name)    \
+    {                                                                      \
+        return mozi::detail::to_string_view_impl(value, flag);             \
+    }                                                                      \
+    inline void to_string(e value, std::string& dest,                      \
+                          mozi::enum_to_string flag =                      \
+                              mozi::enum_to_string::no_show_name)          \
+    {                                                                      \
+        mozi::detail::flags_to_string_impl(value, dest, flag);             \
+    }                                                                      \
+    inline std::string to_string(e value,                                  \
+                                 mozi::enum_to_string flag =               \
+                                     mozi::enum_to_string::no_show_name)   \
+    {                                                                      \
+        std::string result;                                                \
+        mozi::detail::flags_to_string_impl(value, result, flag);           \
+        return result;                                                     \
+    }                                                                      \
+    inline constexpr bool from_string(std::string_view str,                \
+                                      e& value) /* NOLINT */               \
+    {                                                                      \
+        return mozi::detail::flags_from_string_impl(str, value);           \
+    }
+
+#define MOZI_DEFINE_FLAGS_ENUM(e, u, ...)                                  \
+    enum class e : u { __VA_ARGS__ };                                      \
+    inline constexpr std::array<std::pair<u, std::string_view>,            \
+                                MOZI_GET_ARG_COUNT(__VA_ARGS__)>           \
+        e##_enum_map_{                                                     \
+            MOZI_REPEAT_FIRST_ON(MOZI_ENUM_ITEM, e, __VA_ARGS__)};         \
+    MOZI_FLAGS_ENUM_FUNCTIONS(e, u)
+
+#if !defined(DEFINE_FLAGS_ENUM) && !defined(MOZI_NO_DEFINE_FLAGS_ENUM)
+#define DEFINE_FLAGS_ENUM MOZI_DEFINE_FLAGS_ENUM
+#endif
+
+#endif // MOZI_ENUM_REFLECTION_FLAGS_HPP
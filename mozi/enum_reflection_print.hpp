@@ -26,7 +26,7 @@
 
 #include <ostream>                  // std::ostream
 #include <type_traits>              // std::enable_if
-#include "enum_reflection_core.hpp" // IWYU pragma: keep mozi::to_string
+#include "enum_reflection_core.hpp" // IWYU pragma: keep to_string/...
 #include "print.hpp"                // mozi::printer
 #include "type_traits.hpp"          // mozi::is_reflected_enum
 
@@ -37,7 +37,12 @@ struct printer<
     T, std::enable_if_t<is_reflected_enum_v<T> && !is_scoped_enum_v<T>>> {
     void operator()(T value, std::ostream& os, int /*depth*/) const
     {
-        os << to_string(value);
+        auto name = to_string_view(value);
+        if (!name.empty()) {
+            os << name;
+        } else {
+            os << to_string(value);
+        }
     }
 };
 
@@ -46,7 +51,13 @@ struct printer<
     T, std::enable_if_t<is_reflected_enum_v<T> && is_scoped_enum_v<T>>> {
     void operator()(T value, std::ostream& os, int /*depth*/) const
     {
-        os << to_string(value, mozi::enum_to_string::show_name);
+        auto name =
+            to_string_view(value, mozi::enum_to_string::show_name);
+        if (!name.empty()) {
+            os << name;
+        } else {
+            os << to_string(value, mozi::enum_to_string::show_name);
+        }
     }
 };
 
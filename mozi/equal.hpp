@@ -24,9 +24,15 @@
 #ifndef MOZI_EQUAL_HPP
 #define MOZI_EQUAL_HPP
 
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <version>         // IWYU pragma: keep
+#endif
+
+#include <array>           // std::array
 #include <cstddef>         // std::size_t
+#include <cstring>         // std::memcmp
 #include <functional>      // std::equal_to
-#include <type_traits>     // std::is_same
+#include <type_traits>     // std::is_constant_evaluated/is_same/...
 #include <utility>         // std::forward
 #include "type_traits.hpp" // mozi::remove_cvref
 
@@ -46,6 +52,23 @@ struct equality_comparer {
 
 namespace detail {
 
+// Whether the evaluation is in a constant expression, where memcmp cannot
+// be used.  Without compiler support, it is conservatively true.
+constexpr bool is_constant_evaluated() noexcept
+{
+#if __cpp_lib_is_constant_evaluated >= 201811L
+    return std::is_constant_evaluated();
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+#else
+    return true;
+#endif
+}
+
 struct equal_fn {
     template <typename T, typename U>
     constexpr bool operator()(T&& lhs, U&& rhs) const
@@ -60,6 +83,36 @@ struct equal_fn {
 
 inline constexpr detail::equal_fn equal{};
 
+// Type trait for whether two objects of a type are equal exactly when
+// their object representations are equal, so that they can be compared
+// or hashed as raw bytes.  Floating-point numbers are excluded, as 0.0 and
+// -0.0 are equal, and NaN is unequal to itself.  A type with its own
+// equality_comparer shall specialize this trait to std::false_type;
+// otherwise the comparer is bypassed for arrays, spans and reflected
+// structs containing the type.
+template <typename T, typename = void>
+struct is_bitwise_comparable : std::false_type {};
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v =
+    is_bitwise_comparable<T>::value;
+
+template <typename T>
+struct is_bitwise_comparable<
+    T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> ||
+                        std::is_pointer_v<T>>> : std::true_type {};
+
+template <typename T, std::size_t N>
+struct is_bitwise_comparable<
+    T[N], std::enable_if_t<is_bitwise_comparable_v<T>>>
+    : std::true_type {};
+
+template <typename T, std::size_t N>
+struct is_bitwise_comparable<
+    std::array<T, N>,
+    std::enable_if_t<is_bitwise_comparable_v<T> &&
+                     sizeof(std::array<T, N>) == N * sizeof(T)>>
+    : std::true_type {};
+
 template <typename T, typename U, std::size_t N>
 struct equality_comparer<T[N], U[N]> {
     template <typename T1, typename U1>
@@ -68,6 +121,13 @@ struct equality_comparer<T[N], U[N]> {
         static_assert(
             std::is_same_v<std::remove_cv_t<T1>, std::remove_cv_t<T>> &&
             std::is_same_v<std::remove_cv_t<U1>, std::remove_cv_t<U>>);
+        if constexpr (std::is_same_v<std::remove_cv_t<T>,
+                                     std::remove_cv_t<U>> &&
+                      is_bitwise_comparable_v<std::remove_cv_t<T>>) {
+            if (!detail::is_constant_evaluated()) {
+                return std::memcmp(lhs, rhs, sizeof lhs) == 0;
+            }
+        }
         for (std::size_t i = 0; i < N; ++i) {
             if (!mozi::equal(lhs[i], rhs[i])) {
                 return false;
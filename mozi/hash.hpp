@@ -0,0 +1,240 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef MOZI_HASH_HPP
+#define MOZI_HASH_HPP
+
+#include <cstddef>         // std::size_t
+#include <cstdint>         // std::uint64_t/uintptr_t
+#include <cstring>         // std::memcpy
+#include <functional>      // std::hash
+#include <iterator>        // std::data/size
+#include <tuple>           // std::tuple_size/get
+#include <type_traits>     // std::enable_if/is_integral/...
+#include <utility>         // std::declval/index_sequence/...
+#include "equal.hpp"       // mozi::is_bitwise_comparable
+#include "type_traits.hpp" // mozi::is_range/is_tuple_like/...
+
+namespace mozi {
+
+namespace detail {
+
+// Bijective 64-bit mixing function, which makes every input bit affect
+// every output bit
+constexpr std::uint64_t hash_mix(std::uint64_t x)
+{
+    x ^= x >> 32;
+    x *= 0xe9846af9b1a615dULL;
+    x ^= x >> 32;
+    x *= 0xe9846af9b1a615dULL;
+    x ^= x >> 28;
+    return x;
+}
+
+constexpr std::uint64_t rotl64(std::uint64_t x, unsigned n)
+{
+    return (x << n) | (x >> (64 - n));
+}
+
+inline std::uint64_t load_hash_word(const unsigned char* ptr)
+{
+    std::uint64_t result;
+    std::memcpy(&result, ptr, sizeof result);
+    return result;
+}
+
+// Hashes the bytes of an object a 64-bit word at a time.  Long inputs are
+// processed 32 bytes at a time in four independent lanes, so that the
+// multiplications of different lanes can overlap.
+inline std::uint64_t hash_bytes(const void* data, std::size_t size)
+{
+    constexpr std::uint64_t prime1 = 0x9e3779b185ebca87ULL;
+    constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+    auto round = [](std::uint64_t acc, std::uint64_t word) {
+        return rotl64(acc + word * prime2, 31) * prime1;
+    };
+    auto ptr = static_cast<const unsigned char*>(data);
+    std::uint64_t result = size * prime1;
+    if (size >= 32) {
+        std::uint64_t v1 = prime1 + prime2;
+        std::uint64_t v2 = prime2;
+        std::uint64_t v3 = 0;
+        std::uint64_t v4 = 0 - prime1;
+        do {
+            v1 = round(v1, load_hash_word(ptr));
+            v2 = round(v2, load_hash_word(ptr + 8));
+            v3 = round(v3, load_hash_word(ptr + 16));
+            v4 = round(v4, load_hash_word(ptr + 24));
+            ptr += 32;
+            size -= 32;
+        } while (size >= 32);
+        result += rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) +
+                  rotl64(v4, 18);
+    }
+    while (size >= 8) {
+        result = hash_mix(result ^ round(0, load_hash_word(ptr)));
+        ptr += 8;
+        size -= 8;
+    }
+    if (size != 0) {
+        std::uint64_t word{};
+        std::memcpy(&word, ptr, size);
+        result = hash_mix(result ^ round(0, word));
+    }
+    return hash_mix(result);
+}
+
+} // namespace detail
+
+// Combines a hash value into a seed, in a way that depends on the order of
+// combination
+constexpr std::size_t hash_combine(std::size_t seed, std::size_t value)
+{
+    return static_cast<std::size_t>(
+        detail::hash_mix(seed + 0x9e3779b97f4a7c15ULL + value));
+}
+
+// The primary hasher uses std::hash, whose result is mixed, as the
+// standard hash of integers is often the identity function.
+template <typename T, typename = void>
+struct hasher {
+    std::size_t operator()(const T& value) const
+    {
+        return static_cast<std::size_t>(
+            detail::hash_mix(std::hash<T>{}(value)));
+    }
+};
+
+namespace detail {
+
+struct hash_fn {
+    template <typename T>
+    std::size_t operator()(const T& value) const
+    {
+        return hasher<T>{}(value);
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::hash_fn hash{};
+
+// Objects compared bitwise are hashed as raw bytes, and scalars directly
+template <typename T>
+struct hasher<T, std::enable_if_t<is_bitwise_comparable_v<T>>> {
+    std::size_t operator()(const T& value) const
+    {
+        if constexpr (std::is_pointer_v<T>) {
+            return static_cast<std::size_t>(detail::hash_mix(
+                reinterpret_cast<std::uintptr_t>(value)));
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            return static_cast<std::size_t>(
+                detail::hash_mix(static_cast<std::uint64_t>(value)));
+        } else {
+            return static_cast<std::size_t>(
+                detail::hash_bytes(&value, sizeof value));
+        }
+    }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct is_contiguous_range : std::false_type {};
+template <typename T>
+struct is_contiguous_range<
+    T, std::void_t<decltype(std::data(std::declval<const T&>()),
+                            std::size(std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct is_unordered_container : std::false_type {};
+template <typename T>
+struct is_unordered_container<T, std::void_t<typename T::hasher>>
+    : std::true_type {};
+
+} // namespace detail
+
+// Ranges, including standard containers, are hashed by element, and
+// contiguous ranges of elements compared bitwise as raw bytes.  Elements
+// of unordered containers are combined independently of their order, as
+// equal unordered containers may iterate differently.
+template <typename T>
+struct hasher<T, std::enable_if_t<!is_bitwise_comparable_v<T> &&
+                                  !is_reflected_struct_v<T> &&
+                                  is_range_v<const T&>>> {
+    std::size_t operator()(const T& rng) const
+    {
+        using element_type = remove_cvref_t<decltype(*std::begin(rng))>;
+        if constexpr (detail::is_contiguous_range<T>::value &&
+                      is_bitwise_comparable_v<element_type>) {
+            return static_cast<std::size_t>(detail::hash_bytes(
+                std::data(rng), std::size(rng) * sizeof(element_type)));
+        } else if constexpr (detail::is_unordered_container<T>::value) {
+            std::size_t result{};
+            std::size_t count{};
+            for (const auto& elem : rng) {
+                result += mozi::hash(elem);
+                ++count;
+            }
+            return hash_combine(result, count);
+        } else {
+            std::size_t result{};
+            std::size_t count{};
+            for (const auto& elem : rng) {
+                result = hash_combine(result, mozi::hash(elem));
+                ++count;
+            }
+            return hash_combine(result, count);
+        }
+    }
+};
+
+namespace detail {
+
+template <typename T, std::size_t... Is>
+std::size_t hash_tuple(const T& value, std::index_sequence<Is...>)
+{
+    std::size_t result{};
+    ((result = hash_combine(result, mozi::hash(std::get<Is>(value)))),
+     ...);
+    return result;
+}
+
+} // namespace detail
+
+// Tuple-like objects, like pairs and tuples, are hashed by element
+template <typename T>
+struct hasher<T, std::enable_if_t<!is_bitwise_comparable_v<T> &&
+                                  !is_reflected_struct_v<T> &&
+                                  !is_range_v<const T&> &&
+                                  is_tuple_like_v<T>>> {
+    std::size_t operator()(const T& value) const
+    {
+        return detail::hash_tuple(
+            value, std::make_index_sequence<std::tuple_size<T>::value>{});
+    }
+};
+
+} // namespace mozi
+
+#endif // MOZI_HASH_HPP
@@ -0,0 +1,122 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_HOST_PACK_ARRAY_HPP
+#define MOZI_HOST_PACK_ARRAY_HPP
+
+#include <array>              // std::array
+#include <cstddef>            // std::size_t
+#include <type_traits>        // std::enable_if/true_type
+#include "host_pack_core.hpp" // mozi::host_pack::serializer/...
+#include "serialization.hpp"  // mozi::serialize/deserialize/...
+
+namespace mozi::host_pack {
+
+template <typename T, std::size_t N>
+struct is_bitwise_serializable<
+    T[N], std::enable_if_t<is_bitwise_serializable_v<T>>>
+    : std::true_type {};
+
+template <typename T, std::size_t N>
+struct is_bitwise_serializable<
+    std::array<T, N>,
+    std::enable_if_t<is_bitwise_serializable_v<T> &&
+                     sizeof(std::array<T, N>) == N * sizeof(T)>>
+    : std::true_type {};
+
+namespace detail {
+
+template <typename Array, typename T, std::size_t N, typename Sink,
+          typename SerializerList>
+void serialize_array(const Array& arr, const T* elements, Sink& dest,
+                     SerializerList serializers)
+{
+    if constexpr (can_copy_bitwise_v<Array, SerializerList>) {
+        serialize_bitwise(arr, dest);
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            mozi::serialize(elements[i], dest, serializers);
+        }
+    }
+}
+
+template <typename Array, typename T, std::size_t N,
+          typename SerializerList>
+deserialize_result deserialize_array(Array& arr, T* elements,
+                                     deserialize_t& src,
+                                     SerializerList serializers)
+{
+    if constexpr (can_copy_bitwise_v<Array, SerializerList>) {
+        return deserialize_bitwise(arr, src);
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto result = mozi::deserialize(elements[i], src, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+        return deserialize_result::success;
+    }
+}
+
+} // namespace detail
+
+template <typename T, std::size_t N>
+struct serializer<T[N]> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T (&arr)[N], Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_array<T[N], T, N>(arr, arr, dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T (&arr)[N], deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return detail::deserialize_array<T[N], T, N>(arr, arr, src,
+                                                     serializers);
+    }
+};
+
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const std::array<T, N>& arr, Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_array<std::array<T, N>, T, N>(arr, arr.data(),
+                                                        dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(std::array<T, N>& arr,
+                                          deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return detail::deserialize_array<std::array<T, N>, T, N>(
+            arr, arr.data(), src, serializers);
+    }
+};
+
+} // namespace mozi::host_pack
+
+#endif // MOZI_HOST_PACK_ARRAY_HPP
@@ -0,0 +1,87 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_HOST_PACK_BASIC_HPP
+#define MOZI_HOST_PACK_BASIC_HPP
+
+#include <cstddef>            // std::byte
+#include <type_traits>        // std::enable_if/is_arithmetic/is_enum
+#include "host_pack_core.hpp" // mozi::host_pack::serializer/...
+#include "serialization.hpp"  // mozi::deserialize_result/...
+
+namespace mozi::host_pack {
+
+// Bools are not copied bitwise, as a byte other than 0 and 1 does not
+// make a valid bool.
+template <typename T>
+struct is_bitwise_serializable<
+    T, std::enable_if_t<(std::is_arithmetic_v<T> &&
+                         !std::is_same_v<T, bool>) ||
+                        std::is_enum_v<T>>> : std::true_type {};
+
+template <>
+struct serializer<bool> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(bool value, Sink& dest,
+                          SerializerList /*unused*/)
+    {
+        sink_traits<Sink>::put(dest, std::byte{value});
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(bool& value, deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        if (src.empty()) {
+            return deserialize_result::input_truncated;
+        }
+        if (src.front() == std::byte{0}) {
+            value = false;
+        } else if (src.front() == std::byte{1}) {
+            value = true;
+        } else {
+            return deserialize_result::invalid_value;
+        }
+        src = src.subspan(1);
+        return deserialize_result::success;
+    }
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<is_bitwise_serializable_v<T> &&
+                                      std::is_scalar_v<T>>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest, SerializerList /*unused*/)
+    {
+        detail::serialize_bitwise(value, dest);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& value, deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        return detail::deserialize_bitwise(value, src);
+    }
+};
+
+} // namespace mozi::host_pack
+
+#endif // MOZI_HOST_PACK_BASIC_HPP
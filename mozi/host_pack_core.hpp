@@ -0,0 +1,123 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_HOST_PACK_CORE_HPP
+#define MOZI_HOST_PACK_CORE_HPP
+
+// host_pack is a serializer family for data that does not leave the
+// host, like shared memory or on-disk caches.  Fields are stored with
+// their native sizes and byte order, so types whose serialized form is
+// the same as their object representation can be copied in whole.
+
+#include <cstddef>           // std::byte/size_t
+#include <cstring>           // std::memcpy
+#include <type_traits>       // std::false_type/true_type
+#include "serialization.hpp" // mozi::serialize/deserialize/...
+
+namespace mozi::host_pack {
+
+template <typename T, typename = void>
+struct serializer;
+
+// Type trait for whether the serialized form of a type is exactly its
+// object representation.  Such a type is (de)serialized with a single
+// memcpy.
+template <typename T, typename = void>
+struct is_bitwise_serializable : std::false_type {};
+template <typename T>
+inline constexpr bool is_bitwise_serializable_v =
+    is_bitwise_serializable<T>::value;
+
+namespace detail {
+
+// Type trait for whether host_pack::serializer is the first one in a
+// serializer list, i.e., whether host_pack takes care of all the types it
+// supports.
+template <typename SerializerList>
+struct is_host_pack_first : std::false_type {};
+template <template <typename, typename> class... OtherSerializers>
+struct is_host_pack_first<serializer_list<serializer, OtherSerializers...>>
+    : std::true_type {};
+template <typename SerializerList>
+inline constexpr bool is_host_pack_first_v =
+    is_host_pack_first<SerializerList>::value;
+
+// Whether a type can be copied in whole with a serializer list
+template <typename T, typename SerializerList>
+inline constexpr bool can_copy_bitwise_v =
+    is_bitwise_serializable_v<T> && is_host_pack_first_v<SerializerList>;
+
+template <typename T, typename Sink>
+void serialize_bitwise(const T& value, Sink& dest)
+{
+    sink_traits<Sink>::write(
+        dest,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const std::byte*>(&value), sizeof(T));
+}
+
+template <typename T>
+deserialize_result deserialize_bitwise(T& value, deserialize_t& src)
+{
+    if (src.size() < sizeof(T)) {
+        return deserialize_result::input_truncated;
+    }
+    std::memcpy(&value, src.data(), sizeof(T));
+    src = src.subspan(sizeof(T));
+    return deserialize_result::success;
+}
+
+struct serialize_fn {
+    template <typename T, typename Sink>
+    serialize_result operator()(const T& value, Sink& dest) const
+    {
+        static_assert(is_sink_v<Sink>, "Destination must be a sink");
+        if constexpr (is_bitwise_serializable_v<T>) {
+            sink_traits<Sink>::reserve(dest, sizeof(T));
+        }
+        return mozi::serialize(value, dest, serializer_list<serializer>{});
+    }
+
+    template <typename T>
+    serialize_t operator()(const T& value) const
+    {
+        serialize_t result;
+        operator()(value, result);
+        return result;
+    }
+};
+
+struct deserialize_fn {
+    template <typename T>
+    deserialize_result operator()(T& value, deserialize_t& src) const
+    {
+        return mozi::deserialize(value, src, serializer_list<serializer>{});
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::serialize_fn serialize{};
+inline constexpr detail::deserialize_fn deserialize{};
+
+} // namespace mozi::host_pack
+
+#endif // MOZI_HOST_PACK_CORE_HPP
@@ -0,0 +1,110 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_HOST_PACK_STRUCT_REFLECTION_HPP
+#define MOZI_HOST_PACK_STRUCT_REFLECTION_HPP
+
+#include <cstddef>                    // std::size_t
+#include <type_traits>                // std::enable_if/...
+#include <utility>                    // std::index_sequence
+#include "host_pack_core.hpp"         // mozi::host_pack::serializer/...
+#include "serialization.hpp"          // mozi::serialize/deserialize/...
+#include "struct_reflection_core.hpp" // mozi::for_each/get
+#include "type_traits.hpp"            // mozi::is_reflected_struct/...
+
+namespace mozi::host_pack {
+
+namespace detail {
+
+template <typename T, std::size_t... Is>
+constexpr bool
+are_fields_bitwise_serializable(std::index_sequence<Is...>)
+{
+    return (is_bitwise_serializable_v<
+                typename T::template _field<T, Is>::type> &&
+            ...);
+}
+
+} // namespace detail
+
+// A reflected struct without padding, whose fields are all serialized
+// bitwise, is itself serialized bitwise.
+template <typename T>
+struct is_bitwise_serializable<
+    T, std::enable_if_t<mozi::is_reflected_struct_v<T> &&
+                        !mozi::is_bit_fields_container_v<T> &&
+                        std::is_trivially_copyable_v<T> &&
+                        std::has_unique_object_representations_v<T> &&
+                        detail::are_fields_bitwise_serializable<T>(
+                            std::make_index_sequence<T::_size>{})>>
+    : std::true_type {};
+
+template <typename T>
+struct serializer<T,
+                  std::enable_if_t<mozi::is_reflected_struct_v<T> &&
+                                   !mozi::is_bit_fields_container_v<T>>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& obj, Sink& dest,
+                          SerializerList serializers)
+    {
+        if constexpr (detail::can_copy_bitwise_v<T, SerializerList>) {
+            detail::serialize_bitwise(obj, dest);
+        } else {
+            mozi::for_each(
+                obj, [&](auto /*index*/, auto /*name*/, const auto& value) {
+                    mozi::serialize(value, dest, serializers);
+                });
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& obj, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        if constexpr (detail::can_copy_bitwise_v<T, SerializerList>) {
+            return detail::deserialize_bitwise(obj, src);
+        } else {
+            return deserialize_fields(obj, src, serializers,
+                                      std::make_index_sequence<T::_size>{});
+        }
+    }
+
+private:
+    template <typename SerializerList, std::size_t... Is>
+    static deserialize_result
+    deserialize_fields(T& obj, deserialize_t& src,
+                       SerializerList serializers,
+                       std::index_sequence<Is...>)
+    {
+        auto result = deserialize_result::success;
+        auto deserialize_field = [&](auto& value) {
+            result = mozi::deserialize(value, src, serializers);
+            return result == deserialize_result::success;
+        };
+        // Stop at the first failure
+        (void)(deserialize_field(mozi::get<Is>(obj)) && ...);
+        return result;
+    }
+};
+
+} // namespace mozi::host_pack
+
+#endif // MOZI_HOST_PACK_STRUCT_REFLECTION_HPP
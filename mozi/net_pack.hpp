@@ -29,5 +29,8 @@
 #include "net_pack_array.hpp"             // IWYU pragma: keep
 #include "net_pack_struct_reflection.hpp" // IWYU pragma: keep
 #include "net_pack_bit_fields.hpp"        // IWYU pragma: keep
+#include "net_pack_view.hpp"              // IWYU pragma: keep
+#include "net_pack_container.hpp"         // IWYU pragma: keep
+#include "net_pack_utility.hpp"           // IWYU pragma: keep
 
 #endif // MOZI_NET_PACK_HPP
@@ -24,47 +24,270 @@
 #ifndef MOZI_NET_PACK_ARRAY_HPP
 #define MOZI_NET_PACK_ARRAY_HPP
 
-#include <array>             // std::array
-#include <cstddef>           // std::size_t
-#include "net_pack_core.hpp" // mozi::net_pack::serializer
-#include "serialization.hpp" // mozi::serialize/deserialize/...
+#include <algorithm>           // std::min
+#include <array>               // std::array
+#include <climits>             // CHAR_BIT
+#include <cstddef>             // std::byte/size_t
+#include <cstring>             // std::memcpy
+#include <type_traits>         // std::is_integral/make_unsigned/...
+#include "bit_fields_core.hpp" // mozi::pack_bit_fields/...
+#include "endian.hpp"          // mozi::native_endian/byte_swap
+#include "net_pack_core.hpp"   // mozi::net_pack::serializer/...
+#include "serialization.hpp"   // mozi::serialize/deserialize/...
+#include "type_traits.hpp"     // mozi::is_bit_fields_container/...
 
 namespace mozi::net_pack {
 
-template <typename T, std::size_t N>
-struct serializer<T[N]> {
-    template <typename SerializerList>
-    static void serialize(const T (&arr)[N], serialize_t& dest,
-                          SerializerList serializers)
-    {
-        for (const auto& value : arr) {
-            mozi::serialize(value, dest, serializers);
+namespace detail {
+
+// Whether an array of a type can be converted in bulk, instead of element
+// by element.  Multi-byte integers need a known byte order.
+template <typename T>
+inline constexpr bool is_bulk_convertible_v =
+    is_byte_like_v<T> ||
+    (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+     native_endian != endian::unknown);
+
+template <typename T, typename Sink>
+void serialize_array_bulk(const T* arr, std::size_t size, Sink& dest)
+{
+    static_assert(is_bulk_convertible_v<T>);
+    if constexpr (sizeof(T) == 1 || native_endian == endian::big) {
+        sink_traits<Sink>::write(
+            dest,
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            reinterpret_cast<const std::byte*>(arr), size * sizeof(T));
+    } else {
+        // Convert a chunk at a time in a simple loop, which compilers
+        // vectorize into byte shuffles
+        using unsigned_type = std::make_unsigned_t<T>;
+        constexpr std::size_t chunk_size = 256 / sizeof(T);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+        std::array<unsigned_type, chunk_size> buffer;
+        while (size != 0) {
+            auto count = std::min(size, chunk_size);
+            for (std::size_t i = 0; i < count; ++i) {
+                buffer[i] = byte_swap(static_cast<unsigned_type>(arr[i]));
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto bytes = reinterpret_cast<const std::byte*>(buffer.data());
+            sink_traits<Sink>::write(dest, bytes, count * sizeof(T));
+            arr += count;
+            size -= count;
         }
     }
+}
 
-    template <typename SerializerList>
-    static deserialize_result deserialize(T (&arr)[N], deserialize_t& src,
-                                          SerializerList serializers)
+template <typename T>
+void deserialize_array_bulk(T* arr, std::size_t size, const std::byte* src)
+{
+    static_assert(is_bulk_convertible_v<T>);
+    if (size == 0) {
+        return;
+    }
+    std::memcpy(arr, src, size * sizeof(T));
+    if constexpr (sizeof(T) > 1 && native_endian == endian::little) {
+        using unsigned_type = std::make_unsigned_t<T>;
+        for (std::size_t i = 0; i < size; ++i) {
+            arr[i] = static_cast<T>(
+                byte_swap(static_cast<unsigned_type>(arr[i])));
+        }
+    }
+}
+
+// Bit-fields containers whose packed bits make up a whole integer are
+// converted in bulk too: a chunk at a time, they are packed into an array
+// of integers, which is then byte-swapped in bulk.
+template <typename T, typename = void>
+struct bit_fields_bulk_traits {
+    static constexpr bool is_bulk_convertible = false;
+};
+
+template <typename T>
+struct bit_fields_bulk_traits<
+    T, std::enable_if_t<mozi::is_bit_fields_container_v<T>>> {
+    using storage_type = mozi::detail::bit_fields_storage_t<T>;
+    static constexpr std::size_t bits = count_bit_fields<T>();
+
+    static void pack(const T* objs, std::size_t count, storage_type* dest)
+    {
+        pack_bit_fields(objs, count, dest);
+    }
+    static void unpack(T* objs, std::size_t count, const storage_type* src)
     {
-        for (auto& value : arr) {
-            auto result = mozi::deserialize(value, src, serializers);
+        unpack_bit_fields(objs, count, src);
+    }
+};
+
+template <typename T>
+struct bit_fields_bulk_traits<
+    T, std::enable_if_t<mozi::is_packed_bit_fields_container_v<T>>> {
+    using storage_type = typename T::storage_type;
+    static constexpr std::size_t bits =
+        count_bit_fields<typename T::unpacked_type>();
+
+    static void pack(const T* objs, std::size_t count, storage_type* dest)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            dest[i] = objs[i]._bits;
+        }
+    }
+    static void unpack(T* objs, std::size_t count, const storage_type* src)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            objs[i]._bits = src[i];
+        }
+    }
+};
+
+template <typename T, typename Traits = bit_fields_bulk_traits<T>>
+constexpr bool is_bit_fields_bulk_convertible()
+{
+    if constexpr (is_bit_fields_container_v<T> ||
+                  is_packed_bit_fields_container_v<T>) {
+        using storage_type = typename Traits::storage_type;
+        return std::is_integral_v<storage_type> &&
+               sizeof(storage_type) * CHAR_BIT == Traits::bits &&
+               is_bulk_convertible_v<storage_type>;
+    } else {
+        return false;
+    }
+}
+
+template <typename T, typename Sink>
+void serialize_bit_fields_bulk(const T* objs, std::size_t size, Sink& dest)
+{
+    using traits = bit_fields_bulk_traits<T>;
+    constexpr auto chunk_size = mozi::detail::bit_fields_bulk_chunk_size;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    std::array<typename traits::storage_type, chunk_size> buffer;
+    while (size != 0) {
+        auto count = std::min(size, chunk_size);
+        traits::pack(objs, count, buffer.data());
+        serialize_array_bulk(buffer.data(), count, dest);
+        objs += count;
+        size -= count;
+    }
+}
+
+template <typename T>
+void deserialize_bit_fields_bulk(T* objs, std::size_t size,
+                                 const std::byte* src)
+{
+    using traits = bit_fields_bulk_traits<T>;
+    using storage_type = typename traits::storage_type;
+    constexpr auto chunk_size = mozi::detail::bit_fields_bulk_chunk_size;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    std::array<storage_type, chunk_size> buffer;
+    while (size != 0) {
+        auto count = std::min(size, chunk_size);
+        deserialize_array_bulk(buffer.data(), count, src);
+        traits::unpack(objs, count, buffer.data());
+        objs += count;
+        src += count * sizeof(storage_type);
+        size -= count;
+    }
+}
+
+template <typename T, typename Sink, typename SerializerList>
+void serialize_array(const T* arr, std::size_t size, Sink& dest,
+                     SerializerList serializers)
+{
+    if constexpr (is_bulk_convertible_v<T> &&
+                  is_net_pack_first_v<SerializerList>) {
+        serialize_array_bulk(arr, size, dest);
+    } else if constexpr (is_bit_fields_bulk_convertible<T>() &&
+                         is_net_pack_first_v<SerializerList>) {
+        serialize_bit_fields_bulk(arr, size, dest);
+    } else {
+        for (std::size_t i = 0; i < size; ++i) {
+            mozi::serialize(arr[i], dest, serializers);
+        }
+    }
+}
+
+template <typename T>
+deserialize_result deserialize_array_unchecked(T* arr, std::size_t size,
+                                               const std::byte* src)
+{
+    if constexpr (is_bulk_convertible_v<T>) {
+        deserialize_array_bulk(arr, size, src);
+    } else if constexpr (is_bit_fields_bulk_convertible<T>()) {
+        deserialize_bit_fields_bulk(arr, size, src);
+    } else {
+        constexpr auto element_size = serialized_size<T>();
+        for (std::size_t i = 0; i < size; ++i) {
+            auto result = serializer<T>::deserialize_unchecked(
+                arr[i], src + i * element_size);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+    }
+    return deserialize_result::success;
+}
+
+template <typename T, std::size_t N, typename SerializerList>
+deserialize_result deserialize_array(T* arr, deserialize_t& src,
+                                     SerializerList serializers)
+{
+    if constexpr (can_deserialize_unchecked_v<T, SerializerList>) {
+        constexpr auto size = N * serialized_size<T>();
+        if (src.size() < size) {
+            return deserialize_result::input_truncated;
+        }
+        auto result = deserialize_array_unchecked(arr, N, src.data());
+        if (result == deserialize_result::success) {
+            src = src.subspan(size);
+        }
+        return result;
+    } else {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto result = mozi::deserialize(arr[i], src, serializers);
             if (result != deserialize_result::success) {
                 return result;
             }
         }
         return deserialize_result::success;
     }
-};
+}
+
+} // namespace detail
 
 template <typename T, std::size_t N>
-struct serializer<std::array<T, N>> {
+struct serializer<T[N]> : detail::fixed_size_base<N, T> {
+    static constexpr bool sequential = true;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T (&arr)[N], Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_array(arr, N, dest, serializers);
+    }
+
     template <typename SerializerList>
-    static void serialize(const std::array<T, N>& arr, serialize_t& dest,
+    static deserialize_result deserialize(T (&arr)[N], deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return detail::deserialize_array<T, N>(arr, src, serializers);
+    }
+
+    static deserialize_result deserialize_unchecked(T (&arr)[N],
+                                                    const std::byte* src)
+    {
+        return detail::deserialize_array_unchecked(arr, N, src);
+    }
+};
+
+template <typename T, std::size_t N>
+struct serializer<std::array<T, N>> : detail::fixed_size_base<N, T> {
+    static constexpr bool sequential = true;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const std::array<T, N>& arr, Sink& dest,
                           SerializerList serializers)
     {
-        for (const auto& value : arr) {
-            mozi::serialize(value, dest, serializers);
-        }
+        detail::serialize_array(arr.data(), N, dest, serializers);
     }
 
     template <typename SerializerList>
@@ -72,16 +295,17 @@ struct serializer<std::array<T, N>> {
                                           deserialize_t& src,
                                           SerializerList serializers)
     {
-        for (auto& value : arr) {
-            auto result = mozi::deserialize(value, src, serializers);
-            if (result != deserialize_result::success) {
-                return result;
-            }
-        }
-        return deserialize_result::success;
+        return detail::deserialize_array<T, N>(arr.data(), src,
+                                               serializers);
+    }
+
+    static deserialize_result
+    deserialize_unchecked(std::array<T, N>& arr, const std::byte* src)
+    {
+        return detail::deserialize_array_unchecked(arr.data(), N, src);
     }
 };
 
 } // namespace mozi::net_pack
 
-#endif // MOZI_NET_PACK_BASIC_HPP
+#endif // MOZI_NET_PACK_ARRAY_HPP
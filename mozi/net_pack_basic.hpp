@@ -27,18 +27,24 @@
 #include <array>             // std::array
 #include <climits>           // CHAR_BIT/UCHAR_MAX
 #include <cstddef>           // std::byte/size_t
+#include <cstdint>           // std::uint32_t
+#include <limits>            // std::numeric_limits
+#include <stdexcept>         // std::length_error
 #include <type_traits>       // std::enable_if/is_integral/is_enum
-#include "net_pack_core.hpp" // mozi::net_pack::serializer
+#include "net_pack_core.hpp" // mozi::net_pack::serializer/...
 #include "serialization.hpp" // mozi::deserialize_result/...
-#include "type_traits.hpp"   // mozi::is_char/underlying_type
+#include "type_traits.hpp"   // mozi::is_char/is_reflected_enum/...
 
 namespace mozi::net_pack {
 
 template <>
 struct serializer<bool> {
-    static void serialize(bool value, serialize_t& dest)
+    static constexpr std::size_t fixed_size = 1;
+
+    template <typename Sink>
+    static void serialize(bool value, Sink& dest)
     {
-        dest.push_back(std::byte{value});
+        sink_traits<Sink>::put(dest, std::byte{value});
     }
 
     static deserialize_result deserialize(bool& value, deserialize_t& src)
@@ -46,21 +52,29 @@ struct serializer<bool> {
         if (src.empty()) {
             return deserialize_result::input_truncated;
         }
-        if (src.front() == std::byte{0}) {
-            value = false;
+        auto result = deserialize_unchecked(value, src.data());
+        if (result == deserialize_result::success) {
             src = src.subspan(1);
+        }
+        return result;
+    }
+
+    static deserialize_result deserialize_unchecked(bool& value,
+                                                    const std::byte* src)
+    {
+        if (*src == std::byte{0}) {
+            value = false;
             return deserialize_result::success;
         }
-        if (src.front() == std::byte{1}) {
+        if (*src == std::byte{1}) {
             value = true;
-            src = src.subspan(1);
             return deserialize_result::success;
         }
         return deserialize_result::invalid_value;
     }
 
-    template <typename SerializerList>
-    static void serialize(bool value, serialize_t& dest,
+    template <typename Sink, typename SerializerList>
+    static void serialize(bool value, Sink& dest,
                           SerializerList /*unused*/)
     {
         serialize(value, dest);
@@ -75,9 +89,12 @@ struct serializer<bool> {
 
 template <typename T>
 struct serializer<T, std::enable_if_t<is_ordinary_char_v<T>>> {
-    static void serialize(T value, serialize_t& dest)
+    static constexpr std::size_t fixed_size = 1;
+
+    template <typename Sink>
+    static void serialize(T value, Sink& dest)
     {
-        dest.push_back(static_cast<std::byte>(value));
+        sink_traits<Sink>::put(dest, static_cast<std::byte>(value));
     }
 
     static deserialize_result deserialize(T& value, deserialize_t& src)
@@ -90,8 +107,15 @@ struct serializer<T, std::enable_if_t<is_ordinary_char_v<T>>> {
         return deserialize_result::success;
     }
 
-    template <typename SerializerList>
-    static void serialize(T value, serialize_t& dest,
+    static deserialize_result deserialize_unchecked(T& value,
+                                                    const std::byte* src)
+    {
+        value = static_cast<T>(*src);
+        return deserialize_result::success;
+    }
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest,
                           SerializerList /*unused*/)
     {
         serialize(value, dest);
@@ -127,10 +151,13 @@ constexpr std::array<std::byte, sizeof(T)> net_convert(T value)
 template <typename T>
 struct serializer<
     T, std::enable_if_t<std::is_integral_v<T> && (sizeof(T) > 1)>> {
-    static void serialize(T value, serialize_t& dest)
+    static constexpr std::size_t fixed_size = sizeof(T);
+
+    template <typename Sink>
+    static void serialize(T value, Sink& dest)
     {
         auto net_value = detail::net_convert(value);
-        dest.insert(dest.end(), net_value.begin(), net_value.end());
+        sink_traits<Sink>::write(dest, net_value.data(), net_value.size());
     }
 
     static deserialize_result deserialize(T& value, deserialize_t& src)
@@ -138,18 +165,25 @@ struct serializer<
         if (src.size() < sizeof(T)) {
             return deserialize_result::input_truncated;
         }
+        deserialize_unchecked(value, src.data());
+        src = src.subspan(sizeof(T));
+        return deserialize_result::success;
+    }
+
+    static deserialize_result deserialize_unchecked(T& value,
+                                                    const std::byte* src)
+    {
         std::make_unsigned_t<T> unsigned_value{};
         for (std::size_t i = 0; i < sizeof(T); ++i) {
             unsigned_value <<= CHAR_BIT;
             unsigned_value |= static_cast<unsigned char>(src[i]);
         }
         value = static_cast<T>(unsigned_value);
-        src = src.subspan(sizeof(T));
         return deserialize_result::success;
     }
 
-    template <typename SerializerList>
-    static void serialize(T value, serialize_t& dest,
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest,
                           SerializerList /*unused*/)
     {
         serialize(value, dest);
@@ -162,10 +196,30 @@ struct serializer<
     }
 };
 
+namespace detail {
+
+template <typename T>
+constexpr deserialize_result check_enum_value(T value)
+{
+    if constexpr (validate_enum_v<T>) {
+        static_assert(is_reflected_enum_v<T>,
+                      "Only reflected enums can be validated");
+        if (!is_defined(value)) {
+            return deserialize_result::invalid_value;
+        }
+    }
+    return deserialize_result::success;
+}
+
+} // namespace detail
+
 template <typename T>
 struct serializer<T, std::enable_if_t<std::is_enum_v<T>>> {
-    template <typename SerializerList>
-    static void serialize(T value, serialize_t& dest, SerializerList serializers)
+    static constexpr std::size_t fixed_size =
+        serialized_size<mozi::underlying_type_t<T>>();
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(T value, Sink& dest, SerializerList serializers)
     {
         mozi::serialize(static_cast<mozi::underlying_type_t<T>>(value),
                         dest, serializers);
@@ -175,8 +229,30 @@ struct serializer<T, std::enable_if_t<std::is_enum_v<T>>> {
     static deserialize_result deserialize(T& value, deserialize_t& src,
                                           SerializerList serializers)
     {
+        // Like other failures, an invalid value leaves src unchanged
+        auto input = src;
         mozi::underlying_type_t<T> temp;
-        auto result = mozi::deserialize(temp, src, serializers);
+        auto result = mozi::deserialize(temp, input, serializers);
+        if (result == deserialize_result::success) {
+            result = detail::check_enum_value(static_cast<T>(temp));
+        }
+        if (result == deserialize_result::success) {
+            value = static_cast<T>(temp);
+            src = input;
+        }
+        return result;
+    }
+
+    static deserialize_result deserialize_unchecked(T& value,
+                                                    const std::byte* src)
+    {
+        using underlying_type = mozi::underlying_type_t<T>;
+        underlying_type temp;
+        auto result =
+            serializer<underlying_type>::deserialize_unchecked(temp, src);
+        if (result == deserialize_result::success) {
+            result = detail::check_enum_value(static_cast<T>(temp));
+        }
         if (result == deserialize_result::success) {
             value = static_cast<T>(temp);
         }
@@ -184,6 +260,34 @@ struct serializer<T, std::enable_if_t<std::is_enum_v<T>>> {
     }
 };
 
+namespace detail {
+
+// Type of the size prefix of variable-length data
+using size_prefix_type = std::uint32_t;
+
+template <typename Sink>
+void serialize_size_prefix(std::size_t size, Sink& dest)
+{
+    if (size > std::numeric_limits<size_prefix_type>::max()) {
+        throw std::length_error("Data too long to serialize");
+    }
+    serializer<size_prefix_type>::serialize(
+        static_cast<size_prefix_type>(size), dest);
+}
+
+inline deserialize_result deserialize_size_prefix(std::size_t& size,
+                                                  deserialize_t& src)
+{
+    size_prefix_type value{};
+    auto result = serializer<size_prefix_type>::deserialize(value, src);
+    if (result == deserialize_result::success) {
+        size = value;
+    }
+    return result;
+}
+
+} // namespace detail
+
 } // namespace mozi::net_pack
 
 #endif // MOZI_NET_PACK_BASIC_HPP
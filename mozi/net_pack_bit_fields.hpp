@@ -24,58 +24,173 @@
 #ifndef MOZI_NET_PACK_BIT_FIELDS_HPP
 #define MOZI_NET_PACK_BIT_FIELDS_HPP
 
-#include <climits>                    // CHAR_BIT
-#include <cstddef>                    // std::size_t
-#include <type_traits>                // std::enable_if
-#include "bit_fields_core.hpp"        // mozi::count_bit_fields/...
-#include "net_pack_core.hpp"          // mozi::net_pack::serializer
-#include "serialization.hpp"          // mozi::serialize/deserialize/...
-#include "struct_reflection_core.hpp" // mozi::for_each
-#include "type_traits.hpp"            // mozi::is_bit_fields_container/...
+#include <array>               // std::array
+#include <climits>             // CHAR_BIT
+#include <cstddef>             // std::byte/size_t
+#include <cstdint>             // std::uint64_t
+#include <type_traits>         // std::enable_if/is_integral
+#include "bit_fields_core.hpp" // mozi::pack_bit_fields/...
+#include "net_pack_core.hpp"   // mozi::net_pack::serializer
+#include "serialization.hpp"   // mozi::serialize/deserialize/...
+#include "type_traits.hpp"     // mozi::is_bit_fields_container/...
 
 namespace mozi::net_pack {
 
-template <typename T>
-struct serializer<T, std::enable_if_t<mozi::is_bit_fields_container_v<T>>> {
-    static constexpr std::size_t size_bits = count_bit_fields<T>();
-    static_assert(size_bits == 8 || size_bits == 16 || size_bits == 32,
-                  "A bit-fields container must have 8, 16, or 32 bits");
+namespace detail {
+
+// Common part of the serializers of bit-fields containers.  The packed
+// bits are sent in big-endian order in as many bytes as they occupy.  When
+// they make up a whole integer type, the integer is serialized through the
+// serializer list instead, so that other serializers can encode it.
+template <std::size_t Bits>
+struct bit_fields_serializer_base {
+    static_assert(Bits % CHAR_BIT == 0,
+                  "A bit-fields container must have whole bytes");
+    static constexpr std::size_t fixed_size = Bits / CHAR_BIT;
+    using storage_type =
+        typename mozi::detail::bit_fields_storage<Bits>::type;
+    static constexpr bool is_whole_integer =
+        std::is_integral_v<storage_type> &&
+        sizeof(storage_type) * CHAR_BIT == Bits;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize_bits(const storage_type& bits, Sink& dest,
+                               SerializerList serializers)
+    {
+        if constexpr (is_whole_integer) {
+            mozi::serialize(bits, dest, serializers);
+        } else {
+            std::array<std::byte, fixed_size> buffer{};
+            for (std::size_t i = 0; i < fixed_size; ++i) {
+                buffer[i] = get_byte(bits, fixed_size - 1 - i);
+            }
+            sink_traits<Sink>::write(dest, buffer.data(), buffer.size());
+        }
+    }
 
     template <typename SerializerList>
-    static void serialize(T obj, serialize_t& dest,
+    static deserialize_result deserialize_bits(storage_type& bits,
+                                               deserialize_t& src,
+                                               SerializerList serializers)
+    {
+        if constexpr (is_whole_integer) {
+            return mozi::deserialize(bits, src, serializers);
+        } else {
+            if (src.size() < fixed_size) {
+                return deserialize_result::input_truncated;
+            }
+            deserialize_bits_unchecked(bits, src.data());
+            src = src.subspan(fixed_size);
+            return deserialize_result::success;
+        }
+    }
+
+    static void deserialize_bits_unchecked(storage_type& bits,
+                                           const std::byte* src)
+    {
+        if constexpr (is_whole_integer) {
+            serializer<storage_type>::deserialize_unchecked(bits, src);
+        } else {
+            bits = storage_type{};
+            for (std::size_t i = 0; i < fixed_size; ++i) {
+                set_byte(bits, fixed_size - 1 - i, src[i]);
+            }
+        }
+    }
+
+private:
+    // Bytes are numbered from the least significant one
+    static constexpr std::byte get_byte(const storage_type& bits,
+                                        std::size_t index)
+    {
+        if constexpr (std::is_integral_v<storage_type>) {
+            return std::byte(
+                static_cast<unsigned char>(bits >> (index * CHAR_BIT)));
+        } else {
+            return std::byte(static_cast<unsigned char>(
+                bits[index / 8] >> (index % 8 * CHAR_BIT)));
+        }
+    }
+    static constexpr void set_byte(storage_type& bits, std::size_t index,
+                                   std::byte value)
+    {
+        auto word = std::uint64_t{static_cast<unsigned char>(value)};
+        if constexpr (std::is_integral_v<storage_type>) {
+            bits = static_cast<storage_type>(bits |
+                                             word << (index * CHAR_BIT));
+        } else {
+            bits[index / 8] |= word << (index % 8 * CHAR_BIT);
+        }
+    }
+};
+
+} // namespace detail
+
+template <typename T>
+struct serializer<T, std::enable_if_t<mozi::is_bit_fields_container_v<T>>>
+    : detail::bit_fields_serializer_base<count_bit_fields<T>()> {
+    using base = detail::bit_fields_serializer_base<count_bit_fields<T>()>;
+    using typename base::storage_type;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& obj, Sink& dest,
                           SerializerList serializers)
     {
-        using value_type =
-            typename mozi::detail::bits_storage<size_bits>::type;
-        value_type value{};
-        mozi::for_each(
-            obj, [&](auto /*index*/, auto /*name*/, const auto& field) {
-                value <<= remove_cvref_t<decltype(field)>::length;
-                value |= field.underlying_value();
-            });
-        mozi::serialize(value, dest, serializers);
+        base::serialize_bits(pack_bit_fields(obj), dest, serializers);
     }
 
     template <typename SerializerList>
     static deserialize_result deserialize(T& obj, deserialize_t& src,
                                           SerializerList serializers)
     {
-        using value_type =
-            typename mozi::detail::bits_storage<size_bits>::type;
-        constexpr unsigned total_len = sizeof(value_type) * CHAR_BIT;
-        value_type value{};
-        auto ec = mozi::deserialize(value, src, serializers);
+        storage_type bits{};
+        auto ec = base::deserialize_bits(bits, src, serializers);
         if (ec == deserialize_result::success) {
-            mozi::for_each(
-                obj, [&](auto /*index*/, auto /*name*/, auto& field) {
-                    constexpr unsigned len =
-                        remove_cvref_t<decltype(field)>::length;
-                    field = (unsigned{value} >> (total_len - len));
-                    value <<= len;
-                });
+            unpack_bit_fields(obj, bits);
         }
         return ec;
     }
+
+    static deserialize_result deserialize_unchecked(T& obj,
+                                                    const std::byte* src)
+    {
+        storage_type bits{};
+        base::deserialize_bits_unchecked(bits, src);
+        unpack_bit_fields(obj, bits);
+        return deserialize_result::success;
+    }
+};
+
+// A packed container is serialized from its storage, which already has
+// the layout of pack_bit_fields
+template <typename T>
+struct serializer<
+    T, std::enable_if_t<mozi::is_packed_bit_fields_container_v<T>>>
+    : detail::bit_fields_serializer_base<
+          count_bit_fields<typename T::unpacked_type>()> {
+    using base = detail::bit_fields_serializer_base<
+        count_bit_fields<typename T::unpacked_type>()>;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& obj, Sink& dest,
+                          SerializerList serializers)
+    {
+        base::serialize_bits(obj._bits, dest, serializers);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& obj, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        return base::deserialize_bits(obj._bits, src, serializers);
+    }
+
+    static deserialize_result deserialize_unchecked(T& obj,
+                                                    const std::byte* src)
+    {
+        base::deserialize_bits_unchecked(obj._bits, src);
+        return deserialize_result::success;
+    }
 };
 
 } // namespace mozi::net_pack
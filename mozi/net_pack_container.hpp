@@ -0,0 +1,312 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_NET_PACK_CONTAINER_HPP
+#define MOZI_NET_PACK_CONTAINER_HPP
+
+#include <algorithm>          // std::min
+#include <cstddef>            // std::byte/size_t
+#include <string>             // std::basic_string
+#include <type_traits>        // std::bool_constant/enable_if/...
+#include <utility>            // std::move
+#include <vector>             // std::vector
+#include "net_pack_array.hpp" // mozi::net_pack::detail::serialize_array
+#include "net_pack_basic.hpp" // mozi::net_pack::detail::size_prefix_type
+#include "net_pack_core.hpp"  // mozi::net_pack::serializer/...
+#include "net_pack_view.hpp"  // mozi::net_pack::detail::serialize_bytes
+#include "serialization.hpp"  // mozi::serialize/deserialize/...
+#include "type_traits.hpp"    // mozi::is_map/is_ordinary_char
+
+// Containers are serialized with a size prefix, which is the number of
+// elements, followed by the serialized elements.  Besides deserialize,
+// their serializers provide deserialize_size, which reads the size prefix
+// and clears the container, and deserialize_elements, which appends as
+// many of the remaining elements as the input holds.  They declare
+// size_prefixed, so that stream_deserializer can resume a container that
+// spans chunks between its elements, instead of from its beginning.
+
+namespace mozi::net_pack {
+
+namespace detail {
+
+// Whether elements of a type can be serialized as raw bytes in bulk
+template <typename T, typename SerializerList>
+inline constexpr bool is_bulk_copyable_v =
+    is_byte_like_v<T> && is_net_pack_first_v<SerializerList>;
+
+// Type trait for whether a type is serialized as zero bytes, like
+// std::tuple<>.  A size prefix could then demand any number of such
+// elements with no input to check it against, so vectors of them are not
+// serializable.
+template <typename T, typename = void>
+struct is_zero_size : std::false_type {};
+template <typename T>
+struct is_zero_size<T, std::enable_if_t<has_fixed_size_v<T>>>
+    : std::bool_constant<serialized_size<T>() == 0> {};
+template <typename T>
+inline constexpr bool is_zero_size_v = is_zero_size<T>::value;
+
+// Appends the bytes of up to remaining elements from src to a string or a
+// vector of byte-like elements
+template <typename Container>
+deserialize_result append_bytes(Container& value, std::size_t& remaining,
+                                deserialize_t& src)
+{
+    using element_type = typename Container::value_type;
+    auto count = std::min(remaining, src.size());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto data = reinterpret_cast<const element_type*>(src.data());
+    value.insert(value.end(), data, data + count);
+    remaining -= count;
+    src = src.subspan(count);
+    return remaining == 0 ? deserialize_result::success
+                          : deserialize_result::input_truncated;
+}
+
+// Base class of serializers for size-prefixed containers
+struct size_prefixed_base {
+    static constexpr bool size_prefixed = true;
+
+    template <typename T>
+    static deserialize_result
+    deserialize_size(T& value, std::size_t& size, deserialize_t& src)
+    {
+        auto result = deserialize_size_prefix(size, src);
+        if (result == deserialize_result::success) {
+            value.clear();
+        }
+        return result;
+    }
+};
+
+} // namespace detail
+
+template <typename CharT, typename Traits, typename Allocator>
+struct serializer<std::basic_string<CharT, Traits, Allocator>,
+                  std::enable_if_t<is_ordinary_char_v<CharT>>>
+    : detail::size_prefixed_base {
+    template <typename Sink, typename SerializerList>
+    static void
+    serialize(const std::basic_string<CharT, Traits, Allocator>& value,
+              Sink& dest, SerializerList /*unused*/)
+    {
+        sink_traits<Sink>::reserve(
+            dest, sizeof(detail::size_prefix_type) + value.size());
+        detail::serialize_bytes(value.data(), value.size(), dest);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result
+    deserialize(std::basic_string<CharT, Traits, Allocator>& value,
+                deserialize_t& src, SerializerList /*unused*/)
+    {
+        const CharT* data{};
+        std::size_t size{};
+        auto result = detail::deserialize_bytes(data, size, src);
+        if (result == deserialize_result::success) {
+            value.assign(data, size);
+        }
+        return result;
+    }
+
+    template <typename SerializerList>
+    static deserialize_result
+    deserialize_elements(std::basic_string<CharT, Traits, Allocator>& value,
+                         std::size_t& remaining, deserialize_t& src,
+                         SerializerList /*unused*/)
+    {
+        return detail::append_bytes(value, remaining, src);
+    }
+};
+
+template <typename T, typename Allocator>
+struct serializer<std::vector<T, Allocator>,
+                  std::enable_if_t<!detail::is_zero_size_v<T>>>
+    : detail::size_prefixed_base {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const std::vector<T, Allocator>& value,
+                          Sink& dest, SerializerList serializers)
+    {
+        if constexpr (detail::is_bulk_copyable_v<T, SerializerList>) {
+            sink_traits<Sink>::reserve(
+                dest, sizeof(detail::size_prefix_type) + value.size());
+            detail::serialize_bytes(value.data(), value.size(), dest);
+        } else {
+            if constexpr (detail::can_deserialize_unchecked_v<
+                              T, SerializerList>) {
+                sink_traits<Sink>::reserve(
+                    dest, sizeof(detail::size_prefix_type) +
+                              value.size() * serialized_size<T>());
+            }
+            detail::serialize_size_prefix(value.size(), dest);
+            if constexpr (std::is_same_v<T, bool>) {
+                for (bool element : value) {
+                    mozi::serialize(element, dest, serializers);
+                }
+            } else {
+                detail::serialize_array(value.data(), value.size(), dest,
+                                        serializers);
+            }
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(std::vector<T, Allocator>& value,
+                                          deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        if constexpr (detail::is_bulk_copyable_v<T, SerializerList>) {
+            const T* data{};
+            std::size_t size{};
+            auto result = detail::deserialize_bytes(data, size, src);
+            if (result == deserialize_result::success) {
+                value.assign(data, data + size);
+            }
+            return result;
+        } else {
+            auto input = src;
+            std::size_t size{};
+            auto result = detail::deserialize_size_prefix(size, input);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+            // std::vector<bool> has no addressable elements
+            if constexpr (detail::can_deserialize_unchecked_v<
+                              T, SerializerList> &&
+                          !std::is_same_v<T, bool>) {
+                // Check the size only once for all elements
+                constexpr auto element_size = serialized_size<T>();
+                if (input.size() / element_size < size) {
+                    return deserialize_result::input_truncated;
+                }
+                value.resize(size);
+                result = detail::deserialize_array_unchecked(
+                    value.data(), size, input.data());
+                if (result != deserialize_result::success) {
+                    return result;
+                }
+                src = input.subspan(size * element_size);
+            } else {
+                value.clear();
+                // Do not trust the size prefix for memory allocation
+                value.reserve(std::min(size, input.size()));
+                result =
+                    deserialize_elements(value, size, input, serializers);
+                if (result != deserialize_result::success) {
+                    return result;
+                }
+                src = input;
+            }
+            return deserialize_result::success;
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result
+    deserialize_elements(std::vector<T, Allocator>& value,
+                         std::size_t& remaining, deserialize_t& src,
+                         SerializerList serializers)
+    {
+        if constexpr (detail::is_bulk_copyable_v<T, SerializerList>) {
+            return detail::append_bytes(value, remaining, src);
+        } else {
+            for (; remaining != 0; --remaining) {
+                auto input = src;
+                T element{};
+                auto result =
+                    mozi::deserialize(element, input, serializers);
+                if (result != deserialize_result::success) {
+                    return result;
+                }
+                value.push_back(std::move(element));
+                src = input;
+            }
+            return deserialize_result::success;
+        }
+    }
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<is_map_v<T>>>
+    : detail::size_prefixed_base {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& value, Sink& dest,
+                          SerializerList serializers)
+    {
+        detail::serialize_size_prefix(value.size(), dest);
+        for (const auto& [key, mapped] : value) {
+            mozi::serialize(key, dest, serializers);
+            mozi::serialize(mapped, dest, serializers);
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(T& value, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        auto input = src;
+        std::size_t size{};
+        auto result = detail::deserialize_size_prefix(size, input);
+        if (result != deserialize_result::success) {
+            return result;
+        }
+        value.clear();
+        result = deserialize_elements(value, size, input, serializers);
+        if (result != deserialize_result::success) {
+            return result;
+        }
+        src = input;
+        return deserialize_result::success;
+    }
+
+    template <typename SerializerList>
+    static deserialize_result
+    deserialize_elements(T& value, std::size_t& remaining,
+                         deserialize_t& src, SerializerList serializers)
+    {
+        for (; remaining != 0; --remaining) {
+            auto input = src;
+            typename T::key_type key{};
+            typename T::mapped_type mapped{};
+            auto result = mozi::deserialize(key, input, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+            result = mozi::deserialize(mapped, input, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+            // A repeated key would leave fewer entries than the size
+            // prefix claims, except in a multimap
+            auto old_size = value.size();
+            value.emplace(std::move(key), std::move(mapped));
+            if (value.size() == old_size) {
+                return deserialize_result::invalid_value;
+            }
+            src = input;
+        }
+        return deserialize_result::success;
+    }
+};
+
+} // namespace mozi::net_pack
+
+#endif // MOZI_NET_PACK_CONTAINER_HPP
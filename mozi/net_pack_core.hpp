@@ -25,6 +25,9 @@
 #define MOZI_NET_PACK_CORE_HPP
 
 #include <climits>           // CHAR_BIT
+#include <cstddef>           // std::size_t
+#include <type_traits>       // std::false_type/true_type/void_t/...
+#include <utility>           // std::index_sequence
 #include "serialization.hpp" // mozi::serialize/deserialize/...
 
 namespace mozi::net_pack {
@@ -32,15 +35,90 @@ namespace mozi::net_pack {
 template <typename T, typename = void>
 struct serializer;
 
+// Type trait for whether a type always has the same size on the wire.  A
+// serializer indicates this by providing a static data member fixed_size.
+// It shall then also provide a static member function
+//
+//   deserialize_result deserialize_unchecked(T&, const std::byte*)
+//
+// which may assume that fixed_size bytes are available at the pointer.
+template <typename T, typename = void>
+struct has_fixed_size : std::false_type {};
+template <typename T>
+struct has_fixed_size<
+    T, std::void_t<decltype(serializer<std::remove_cv_t<T>>::fixed_size)>>
+    : std::true_type {};
+template <typename T>
+inline constexpr bool has_fixed_size_v = has_fixed_size<T>::value;
+
+// Type trait for whether deserialization of an enum shall fail with
+// deserialize_result::invalid_value when the value is not one of its
+// enumerators.  Specialize it to std::true_type for a reflected enum to
+// opt in; the check uses the is_defined function generated for the enum.
+template <typename T>
+struct validate_enum : std::false_type {};
+template <typename T>
+inline constexpr bool validate_enum_v = validate_enum<T>::value;
+
+template <typename T>
+constexpr std::size_t serialized_size()
+{
+    static_assert(has_fixed_size_v<T>,
+                  "Type does not have a fixed serialized size");
+    return serializer<std::remove_cv_t<T>>::fixed_size;
+}
+
 namespace detail {
 
+// Type trait for whether net_pack::serializer is the first one in a
+// serializer list, i.e., whether net_pack takes care of all the types it
+// supports.
+template <typename SerializerList>
+struct is_net_pack_first : std::false_type {};
+template <template <typename, typename> class... OtherSerializers>
+struct is_net_pack_first<serializer_list<serializer, OtherSerializers...>>
+    : std::true_type {};
+template <typename SerializerList>
+inline constexpr bool is_net_pack_first_v =
+    is_net_pack_first<SerializerList>::value;
+
+// Whether a type can be deserialized with deserialize_unchecked after a
+// single size check
+template <typename T, typename SerializerList>
+inline constexpr bool can_deserialize_unchecked_v =
+    has_fixed_size_v<T> && is_net_pack_first_v<SerializerList>;
+
+// Base class of serializers for aggregates: fixed_size is provided only
+// when all the component types have a fixed size.
+template <typename Enable, std::size_t Count, typename... Ts>
+struct fixed_size_base_impl {};
+template <std::size_t Count, typename... Ts>
+struct fixed_size_base_impl<
+    std::enable_if_t<(has_fixed_size_v<Ts> && ...)>, Count, Ts...> {
+    static constexpr std::size_t fixed_size =
+        Count * (std::size_t{} + ... + serialized_size<Ts>());
+};
+template <std::size_t Count, typename... Ts>
+using fixed_size_base = fixed_size_base_impl<void, Count, Ts...>;
+
+template <typename T, std::size_t... Is>
+auto get_struct_fixed_size_base(std::index_sequence<Is...>)
+    -> fixed_size_base<1, typename T::template _field<T, Is>::type...>;
+template <typename T>
+using struct_fixed_size_base = decltype(get_struct_fixed_size_base<T>(
+    std::make_index_sequence<T::_size>{}));
+
 struct serialize_fn {
     static_assert(CHAR_BIT == 8);
 
-    template <typename T>
-    void operator()(const T& value, serialize_t& dest) const
+    template <typename T, typename Sink>
+    serialize_result operator()(const T& value, Sink& dest) const
     {
-        mozi::serialize(value, dest, serializer_list<serializer>{});
+        static_assert(is_sink_v<Sink>, "Destination must be a sink");
+        if constexpr (has_fixed_size_v<T>) {
+            sink_traits<Sink>::reserve(dest, serialized_size<T>());
+        }
+        return mozi::serialize(value, dest, serializer_list<serializer>{});
     }
 
     template <typename T>
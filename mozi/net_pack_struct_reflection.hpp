@@ -24,10 +24,12 @@
 #ifndef MOZI_NET_PACK_STRUCT_REFLECTION_HPP
 #define MOZI_NET_PACK_STRUCT_REFLECTION_HPP
 
+#include <cstddef>                    // std::byte/size_t
 #include <type_traits>                // std::enable_if
-#include "net_pack_core.hpp"          // mozi::net_pack::serializer
+#include <utility>                    // std::index_sequence/...
+#include "net_pack_core.hpp"          // mozi::net_pack::serializer/...
 #include "serialization.hpp"          // mozi::serialize/deserialize/...
-#include "struct_reflection_core.hpp" // mozi::for_each
+#include "struct_reflection_core.hpp" // mozi::for_each/get
 #include "type_traits.hpp"            // mozi::is_reflected_struct/...
 
 namespace mozi::net_pack {
@@ -35,9 +37,12 @@ namespace mozi::net_pack {
 template <typename T>
 struct serializer<T,
                   std::enable_if_t<mozi::is_reflected_struct_v<T> &&
-                                   !mozi::is_bit_fields_container_v<T>>> {
-    template <typename SerializerList>
-    static void serialize(T obj, serialize_t& dest,
+                                   !mozi::is_bit_fields_container_v<T>>>
+    : detail::struct_fixed_size_base<T> {
+    static constexpr bool sequential = true;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(const T& obj, Sink& dest,
                           SerializerList serializers)
     {
         mozi::for_each(
@@ -49,14 +54,63 @@ struct serializer<T,
     template <typename SerializerList>
     static deserialize_result deserialize(T& obj, deserialize_t& src,
                                           SerializerList serializers)
+    {
+        if constexpr (detail::can_deserialize_unchecked_v<T,
+                                                          SerializerList>) {
+            // Check the size only once for the whole struct
+            constexpr auto size = serialized_size<T>();
+            if (src.size() < size) {
+                return deserialize_result::input_truncated;
+            }
+            auto result = deserialize_unchecked(obj, src.data());
+            if (result == deserialize_result::success) {
+                src = src.subspan(size);
+            }
+            return result;
+        } else {
+            return deserialize_fields(obj, src, serializers,
+                                      std::make_index_sequence<T::_size>{});
+        }
+    }
+
+    static deserialize_result deserialize_unchecked(T& obj,
+                                                    const std::byte* src)
+    {
+        return deserialize_fields_unchecked(
+            obj, src, std::make_index_sequence<T::_size>{});
+    }
+
+private:
+    template <typename SerializerList, std::size_t... Is>
+    static deserialize_result
+    deserialize_fields(T& obj, deserialize_t& src,
+                       SerializerList serializers,
+                       std::index_sequence<Is...>)
     {
         auto result = deserialize_result::success;
-        mozi::for_each(
-            obj, [&](auto /*index*/, auto /*name*/, auto& value) {
-                if (result == deserialize_result::success) {
-                    result = mozi::deserialize(value, src, serializers);
-                }
-            });
+        auto deserialize_field = [&](auto& value) {
+            result = mozi::deserialize(value, src, serializers);
+            return result == deserialize_result::success;
+        };
+        // Stop at the first failure
+        (void)(deserialize_field(mozi::get<Is>(obj)) && ...);
+        return result;
+    }
+
+    template <std::size_t... Is>
+    static deserialize_result
+    deserialize_fields_unchecked(T& obj, const std::byte* src,
+                                 std::index_sequence<Is...>)
+    {
+        auto result = deserialize_result::success;
+        auto deserialize_field = [&](auto& value) {
+            using value_type = remove_cvref_t<decltype(value)>;
+            result =
+                serializer<value_type>::deserialize_unchecked(value, src);
+            src += serialized_size<value_type>();
+            return result == deserialize_result::success;
+        };
+        (void)(deserialize_field(mozi::get<Is>(obj)) && ...);
         return result;
     }
 };
@@ -0,0 +1,168 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_NET_PACK_UTILITY_HPP
+#define MOZI_NET_PACK_UTILITY_HPP
+
+#include <cstddef>           // std::byte/size_t
+#include <optional>          // std::optional
+#include <tuple>             // std::tuple/apply/get
+#include <utility>           // std::pair/index_sequence
+#include "net_pack_core.hpp" // mozi::net_pack::serializer/...
+#include "serialization.hpp" // mozi::serialize/deserialize/...
+#include "type_traits.hpp"   // mozi::remove_cvref_t
+
+namespace mozi::net_pack {
+
+namespace detail {
+
+template <typename Tuple, typename SerializerList, std::size_t... Is>
+deserialize_result deserialize_elements(Tuple& value, deserialize_t& src,
+                                        SerializerList serializers,
+                                        std::index_sequence<Is...>)
+{
+    auto result = deserialize_result::success;
+    auto deserialize_element = [&](auto& element) {
+        result = mozi::deserialize(element, src, serializers);
+        return result == deserialize_result::success;
+    };
+    // Stop at the first failure
+    (void)(deserialize_element(std::get<Is>(value)) && ...);
+    return result;
+}
+
+template <typename Tuple, std::size_t... Is>
+deserialize_result
+deserialize_elements_unchecked(Tuple& value, const std::byte* src,
+                               std::index_sequence<Is...>)
+{
+    auto result = deserialize_result::success;
+    auto deserialize_element = [&](auto& element) {
+        using element_type = remove_cvref_t<decltype(element)>;
+        result =
+            serializer<element_type>::deserialize_unchecked(element, src);
+        src += serialized_size<element_type>();
+        return result == deserialize_result::success;
+    };
+    (void)(deserialize_element(std::get<Is>(value)) && ...);
+    return result;
+}
+
+// Serializer for pairs and tuples, whose elements are serialized in order
+// without any prefix
+template <typename Tuple, typename... Ts>
+struct tuple_serializer : fixed_size_base<1, Ts...> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const Tuple& value, Sink& dest,
+                          SerializerList serializers)
+    {
+        std::apply(
+            [&](const auto&... elements) {
+                (mozi::serialize(elements, dest, serializers), ...);
+            },
+            value);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(Tuple& value, deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        if constexpr (can_deserialize_unchecked_v<Tuple, SerializerList>) {
+            constexpr auto size = serialized_size<Tuple>();
+            if (src.size() < size) {
+                return deserialize_result::input_truncated;
+            }
+            auto result = deserialize_unchecked(value, src.data());
+            if (result == deserialize_result::success) {
+                src = src.subspan(size);
+            }
+            return result;
+        } else {
+            auto input = src;
+            auto result = deserialize_elements(
+                value, input, serializers,
+                std::index_sequence_for<Ts...>{});
+            if (result == deserialize_result::success) {
+                src = input;
+            }
+            return result;
+        }
+    }
+
+    static deserialize_result deserialize_unchecked(Tuple& value,
+                                                    const std::byte* src)
+    {
+        return deserialize_elements_unchecked(
+            value, src, std::index_sequence_for<Ts...>{});
+    }
+};
+
+} // namespace detail
+
+template <typename T, typename U>
+struct serializer<std::pair<T, U>>
+    : detail::tuple_serializer<std::pair<T, U>, T, U> {};
+
+template <typename... Ts>
+struct serializer<std::tuple<Ts...>>
+    : detail::tuple_serializer<std::tuple<Ts...>, Ts...> {};
+
+// An optional value is serialized as a presence flag (a bool), followed by
+// the value if it is present.
+template <typename T>
+struct serializer<std::optional<T>> {
+    template <typename Sink, typename SerializerList>
+    static void serialize(const std::optional<T>& value, Sink& dest,
+                          SerializerList serializers)
+    {
+        mozi::serialize(value.has_value(), dest, serializers);
+        if (value) {
+            mozi::serialize(*value, dest, serializers);
+        }
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(std::optional<T>& value,
+                                          deserialize_t& src,
+                                          SerializerList serializers)
+    {
+        auto input = src;
+        bool has_value{};
+        auto result = mozi::deserialize(has_value, input, serializers);
+        if (result != deserialize_result::success) {
+            return result;
+        }
+        if (!has_value) {
+            value.reset();
+        } else {
+            result = mozi::deserialize(value.emplace(), input, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+        src = input;
+        return deserialize_result::success;
+    }
+};
+
+} // namespace mozi::net_pack
+
+#endif // MOZI_NET_PACK_UTILITY_HPP
@@ -0,0 +1,133 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_NET_PACK_VIEW_HPP
+#define MOZI_NET_PACK_VIEW_HPP
+
+#include <cstddef>            // std::byte/size_t
+#include <string_view>        // std::basic_string_view
+#include <type_traits>        // std::enable_if/is_const/remove_const
+#include "net_pack_basic.hpp" // mozi::net_pack::detail::size_prefix_type
+#include "net_pack_core.hpp"  // mozi::net_pack::serializer
+#include "serialization.hpp"  // mozi::sink_traits/is_byte_like/...
+#include "span.hpp"           // mozi::span
+#include "type_traits.hpp"    // mozi::is_ordinary_char
+
+// Views of byte or character sequences are serialized with a size prefix,
+// like strings and vectors.  When deserialized, a view points directly
+// into the source buffer, without any copying.  It is therefore valid only
+// while the source buffer is alive and unmodified.  The serializers
+// declare borrows_input, so that stream_deserializer, which may buffer the
+// input internally, rejects views at compile time.
+
+namespace mozi::net_pack {
+
+namespace detail {
+
+template <typename T, typename Sink>
+void serialize_bytes(const T* data, std::size_t size, Sink& dest)
+{
+    serialize_size_prefix(size, dest);
+    sink_traits<Sink>::write(
+        dest,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const std::byte*>(data), size);
+}
+
+template <typename T>
+deserialize_result deserialize_bytes(const T*& data, std::size_t& size,
+                                     deserialize_t& src)
+{
+    auto input = src;
+    auto result = deserialize_size_prefix(size, input);
+    if (result != deserialize_result::success) {
+        return result;
+    }
+    if (input.size() < size) {
+        return deserialize_result::input_truncated;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    data = reinterpret_cast<const T*>(input.data());
+    src = input.subspan(size);
+    return deserialize_result::success;
+}
+
+} // namespace detail
+
+template <typename CharT, typename Traits>
+struct serializer<std::basic_string_view<CharT, Traits>,
+                  std::enable_if_t<is_ordinary_char_v<CharT>>> {
+    static constexpr bool borrows_input = true;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(std::basic_string_view<CharT, Traits> value,
+                          Sink& dest, SerializerList /*unused*/)
+    {
+        detail::serialize_bytes(value.data(), value.size(), dest);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result
+    deserialize(std::basic_string_view<CharT, Traits>& value,
+                deserialize_t& src, SerializerList /*unused*/)
+    {
+        const CharT* data{};
+        std::size_t size{};
+        auto result = detail::deserialize_bytes(data, size, src);
+        if (result == deserialize_result::success) {
+            value = std::basic_string_view<CharT, Traits>(data, size);
+        }
+        return result;
+    }
+};
+
+template <typename T>
+struct serializer<
+    span<T>, std::enable_if_t<is_byte_like_v<std::remove_const_t<T>>>> {
+    static constexpr bool borrows_input = true;
+
+    template <typename Sink, typename SerializerList>
+    static void serialize(span<T> value, Sink& dest,
+                          SerializerList /*unused*/)
+    {
+        detail::serialize_bytes(value.data(), value.size(), dest);
+    }
+
+    template <typename SerializerList>
+    static deserialize_result deserialize(span<T>& value,
+                                          deserialize_t& src,
+                                          SerializerList /*unused*/)
+    {
+        static_assert(std::is_const_v<T>,
+                      "Only views of const data can be deserialized");
+        T* data{};
+        std::size_t size{};
+        auto result = detail::deserialize_bytes(data, size, src);
+        if (result == deserialize_result::success) {
+            value = span<T>(data, size);
+        }
+        return result;
+    }
+};
+
+} // namespace mozi::net_pack
+
+#endif // MOZI_NET_PACK_VIEW_HPP
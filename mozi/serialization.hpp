@@ -24,9 +24,11 @@
 #ifndef MOZI_SERIALIZE_HPP
 #define MOZI_SERIALIZE_HPP
 
-#include <cstddef>         // std::byte
+#include <algorithm>       // std::max
+#include <cstddef>         // std::byte/size_t
 #include <tuple>           // std::tuple
-#include <type_traits>     // std::is_same
+#include <type_traits>     // std::is_same/void_t/...
+#include <utility>         // std::declval
 #include <vector>          // std::vector
 #include "span.hpp"        // mozi::span
 #include "type_traits.hpp" // mozi::always_false/is_type_complete/...
@@ -55,6 +57,11 @@ using serialize_t = std::vector<std::byte>;
 #endif
 using deserialize_t = span<const std::byte>;
 
+enum class serialize_result {
+    success,
+    output_overflow,
+};
+
 enum class deserialize_result {
     success,
     input_truncated,
@@ -62,12 +69,144 @@ enum class deserialize_result {
     unexpected_input_data,
 };
 
+// Type trait for byte-sized types that can hold serialized data
+template <typename T>
+struct is_byte_like
+    : std::bool_constant<std::is_same_v<T, std::byte> ||
+                         is_ordinary_char_v<T>> {};
+template <typename T>
+inline constexpr bool is_byte_like_v = is_byte_like<T>::value;
+
+namespace detail {
+
+template <typename Sink, typename = void>
+struct has_write_member : std::false_type {};
+template <typename Sink>
+struct has_write_member<
+    Sink, std::void_t<decltype(std::declval<Sink&>().write(
+              std::declval<const std::byte*>(), std::size_t{}))>>
+    : std::true_type {};
+
+template <typename Sink, typename = void>
+struct has_reserve_member : std::false_type {};
+template <typename Sink>
+struct has_reserve_member<
+    Sink,
+    std::void_t<decltype(std::declval<Sink&>().reserve(std::size_t{}))>>
+    : std::true_type {};
+
+template <typename Sink, typename = void>
+struct has_overflowed_member : std::false_type {};
+template <typename Sink>
+struct has_overflowed_member<
+    Sink, std::void_t<decltype(std::declval<const Sink&>().overflowed())>>
+    : std::true_type {};
+
+template <typename Sink, typename = void>
+struct is_byte_container : std::false_type {};
+template <typename Sink>
+struct is_byte_container<
+    Sink, std::void_t<decltype(std::declval<Sink&>().insert(
+              std::declval<Sink&>().end(),
+              std::declval<const typename Sink::value_type*>(),
+              std::declval<const typename Sink::value_type*>()))>>
+    : is_byte_like<typename Sink::value_type> {};
+
+} // namespace detail
+
+// Traits for the destination of serialization, i.e. a sink.  Serializers
+// write to a sink only via the static member functions
+//
+//   void write(Sink&, const std::byte* data, std::size_t size)
+//   void put(Sink&, std::byte value)
+//   void reserve(Sink&, std::size_t extra_size)
+//   bool overflowed(const Sink&)
+//
+// where reserve is only a hint that so many more bytes are about to be
+// written, and overflowed tells whether some data could not be written.
+// Sequence containers of byte-like types (like serialize_t, std::string,
+// and std::vector<char>) are supported by default, and so are types that
+// have a member function write(const std::byte*, std::size_t), and
+// optionally member functions reserve(std::size_t) and overflowed().
+// Users may specialize this template for other sinks.
+template <typename Sink, typename = void>
+struct sink_traits;
+
+template <typename Sink>
+struct sink_traits<
+    Sink, std::enable_if_t<detail::is_byte_container<Sink>::value &&
+                           !detail::has_write_member<Sink>::value>> {
+    using value_type = typename Sink::value_type;
+
+    static void write(Sink& dest, const std::byte* data, std::size_t size)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto first = reinterpret_cast<const value_type*>(data);
+        dest.insert(dest.end(), first, first + size);
+    }
+    static void put(Sink& dest, std::byte value)
+    {
+        dest.push_back(static_cast<value_type>(value));
+    }
+    static void reserve([[maybe_unused]] Sink& dest,
+                        [[maybe_unused]] std::size_t extra_size)
+    {
+        if constexpr (detail::has_reserve_member<Sink>::value) {
+            // Keep the geometric growth, but do not reallocate more than
+            // once for the coming data
+            if (dest.capacity() - dest.size() < extra_size) {
+                dest.reserve(std::max(dest.size() + extra_size,
+                                      dest.capacity() * 2));
+            }
+        }
+    }
+    static constexpr bool overflowed(const Sink& /*dest*/)
+    {
+        return false;
+    }
+};
+
+template <typename Sink>
+struct sink_traits<
+    Sink, std::enable_if_t<detail::has_write_member<Sink>::value>> {
+    static void write(Sink& dest, const std::byte* data, std::size_t size)
+    {
+        dest.write(data, size);
+    }
+    static void put(Sink& dest, std::byte value)
+    {
+        dest.write(&value, 1);
+    }
+    static void reserve([[maybe_unused]] Sink& dest,
+                        [[maybe_unused]] std::size_t extra_size)
+    {
+        if constexpr (detail::has_reserve_member<Sink>::value) {
+            dest.reserve(extra_size);
+        }
+    }
+    static bool overflowed([[maybe_unused]] const Sink& dest)
+    {
+        if constexpr (detail::has_overflowed_member<Sink>::value) {
+            return dest.overflowed();
+        } else {
+            return false;
+        }
+    }
+};
+
+// Type trait for whether a type can be used as a sink
+template <typename Sink>
+struct is_sink : is_type_complete<sink_traits<Sink>> {};
+template <typename Sink>
+inline constexpr bool is_sink_v = is_sink<Sink>::value;
+
 // Type for storing a list of serializers.  There are no data members and
 // only the type counts.
 //
 // A serializer shall have two template parameters: the first is the type to
 // be serialized, and the second is used for SFINAE.  A serializer should
-// have two static member functions, specialized for supported types.  See
+// have two static member functions, specialized for supported types.  The
+// serialization function may accept any sink, or only serialize_t.  See
 // net_pack_basic.hpp for examples.
 template <template <typename, typename> class... Serializers>
 struct serializer_list;
@@ -82,10 +221,10 @@ struct serializer_list<FirstSerializer, OtherSerializers...> {
 namespace detail {
 
 struct serialize_fn {
-    template <typename T,
+    template <typename T, typename Sink,
               typename SerializerListCurr,
               typename SerializerListFull>
-    void try_serialize(const T& value, serialize_t& dest,
+    void try_serialize(const T& value, Sink& dest,
                        SerializerListCurr /*current*/,
                        SerializerListFull all_serializers) const
     {
@@ -106,11 +245,11 @@ struct serialize_fn {
                           all_serializers);
         }
     }
-    template <std::size_t I, typename T,
+    template <std::size_t I, typename T, typename Sink,
               typename SerializerListCurr,
               typename SerializerListFull,
               typename Tuple>
-    void try_serialize(const T& value, serialize_t& dest,
+    void try_serialize(const T& value, Sink& dest,
                        SerializerListCurr /*current*/,
                        SerializerListFull all_serializers,
                        const Tuple& state_ptrs) const
@@ -140,19 +279,31 @@ struct serialize_fn {
                 all_serializers, state_ptrs);
         }
     }
-    template <typename T, typename SerializerList>
-    void operator()(const T& value, serialize_t& dest,
-                    SerializerList serializers) const
+    template <typename T, typename Sink, typename SerializerList>
+    serialize_result operator()(const T& value, Sink& dest,
+                                SerializerList serializers) const
     {
         try_serialize(value, dest, serializers, serializers);
+        return get_result(dest);
     }
-    template <typename T, typename SerializerList, typename Tuple>
-    void operator()(const T& value, serialize_t& dest,
-                    SerializerList serializers,
-                    const Tuple& state_ptrs) const
+    template <typename T, typename Sink, typename SerializerList,
+              typename Tuple>
+    serialize_result operator()(const T& value, Sink& dest,
+                                SerializerList serializers,
+                                const Tuple& state_ptrs) const
     {
         static_assert(is_tuple_like_v<Tuple>, "state_ptrs must be a tuple");
         try_serialize<0>(value, dest, serializers, serializers, state_ptrs);
+        return get_result(dest);
+    }
+
+private:
+    template <typename Sink>
+    static serialize_result get_result(const Sink& dest)
+    {
+        return sink_traits<Sink>::overflowed(dest)
+                   ? serialize_result::output_overflow
+                   : serialize_result::success;
     }
 };
 
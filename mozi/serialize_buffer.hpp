@@ -0,0 +1,144 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_SERIALIZE_BUFFER_HPP
+#define MOZI_SERIALIZE_BUFFER_HPP
+
+#include <array>             // std::array
+#include <cstddef>           // std::byte/size_t
+#include <cstring>           // std::memcpy
+#include "serialization.hpp" // IWYU pragma: keep mozi::sink_traits
+#include "span.hpp"          // mozi::span
+
+namespace mozi {
+
+// Sink that writes to a caller-owned memory region, which may be a stack
+// array, a ring buffer slot, or a memory-mapped file.  It never
+// allocates.  When some data do not fit, they are not written, and the
+// sink is marked as overflowed, so that nothing more is written.
+class buffer_sink {
+public:
+    constexpr explicit buffer_sink(span<std::byte> buffer) noexcept
+        : buffer_(buffer)
+    {
+    }
+
+    void write(const std::byte* data, std::size_t size) noexcept
+    {
+        if (overflowed_ || size > buffer_.size() - size_) {
+            overflowed_ = true;
+            return;
+        }
+        if (size != 0) {
+            std::memcpy(buffer_.data() + size_, data, size);
+            size_ += size;
+        }
+    }
+
+    constexpr std::byte* data() const noexcept
+    {
+        return buffer_.data();
+    }
+    constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+    constexpr std::size_t capacity() const noexcept
+    {
+        return buffer_.size();
+    }
+    constexpr bool overflowed() const noexcept
+    {
+        return overflowed_;
+    }
+    constexpr span<const std::byte> written() const noexcept
+    {
+        return buffer_.first(size_);
+    }
+
+    constexpr void clear() noexcept
+    {
+        size_ = 0;
+        overflowed_ = false;
+    }
+
+private:
+    span<std::byte> buffer_;
+    std::size_t size_{};
+    bool overflowed_{};
+};
+
+// Serialization buffer of a fixed capacity, which can live on the stack
+// and never allocates.  When some data do not fit, they are not written,
+// and the buffer is marked as overflowed, which makes serialization return
+// serialize_result::output_overflow.  It is a buffer_sink over its own
+// array, and thus cannot be copied or moved.
+template <std::size_t N>
+class static_serialize_buffer {
+public:
+    static_serialize_buffer() noexcept : sink_(span<std::byte>(buffer_))
+    {
+    }
+    static_serialize_buffer(const static_serialize_buffer&) = delete;
+    static_serialize_buffer&
+    operator=(const static_serialize_buffer&) = delete;
+
+    void write(const std::byte* data, std::size_t size) noexcept
+    {
+        sink_.write(data, size);
+    }
+
+    constexpr const std::byte* data() const noexcept
+    {
+        return sink_.data();
+    }
+    constexpr std::size_t size() const noexcept
+    {
+        return sink_.size();
+    }
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+    constexpr bool overflowed() const noexcept
+    {
+        return sink_.overflowed();
+    }
+    constexpr span<const std::byte> written() const noexcept
+    {
+        return sink_.written();
+    }
+
+    constexpr void clear() noexcept
+    {
+        sink_.clear();
+    }
+
+private:
+    // Not initialized, as only the written part is ever read
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    std::array<std::byte, N> buffer_;
+    buffer_sink sink_;
+};
+
+} // namespace mozi
+
+#endif // MOZI_SERIALIZE_BUFFER_HPP
@@ -43,8 +43,9 @@
 #error "No span support is detected"
 #endif
 
+#include <cstring>     // std::memcmp
 #include <type_traits> // std::is_same/remove_cv
-#include "equal.hpp"   // mozi::equal
+#include "equal.hpp"   // mozi::equal/is_bitwise_comparable/...
 
 namespace mozi {
 
@@ -65,6 +66,15 @@ struct equality_comparer<span<T>, span<U>, void> {
         if (lhs.size() != rhs.size()) {
             return false;
         }
+        if constexpr (std::is_same_v<std::remove_cv_t<T>,
+                                     std::remove_cv_t<U>> &&
+                      is_bitwise_comparable_v<std::remove_cv_t<T>>) {
+            if (!detail::is_constant_evaluated()) {
+                return lhs.empty() ||
+                       std::memcmp(lhs.data(), rhs.data(),
+                                   lhs.size_bytes()) == 0;
+            }
+        }
         auto it1 = lhs.begin();
         auto it2 = rhs.begin();
         while (it1 != lhs.end()) {
@@ -0,0 +1,396 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef MOZI_STREAM_DESERIALIZER_HPP
+#define MOZI_STREAM_DESERIALIZER_HPP
+
+#include <algorithm>                  // std::min
+#include <array>                      // std::array
+#include <cstddef>                    // std::byte/ptrdiff_t/size_t
+#include <tuple>                      // std::tuple_element/tuple_size
+#include <type_traits>                // std::conditional/enable_if/...
+#include <utility>                    // std::declval/index_sequence/...
+#include <vector>                     // std::vector
+#include "serialization.hpp"          // mozi::deserialize/serializer_list
+#include "struct_reflection_core.hpp" // mozi::for_each/for_each_meta
+#include "type_traits.hpp"            // mozi::is_reflected_struct/...
+
+namespace mozi {
+
+namespace detail {
+
+// Finds the serializer in a serializer list that handles a type; the
+// result is void if no serializer does.
+template <typename T, typename SerializerList>
+struct find_serializer;
+template <typename T>
+struct find_serializer<T, serializer_list<>> {
+    using type = void;
+};
+template <typename T, template <typename, typename> class FirstSerializer,
+          template <typename, typename> class... OtherSerializers>
+struct find_serializer<
+    T, serializer_list<FirstSerializer, OtherSerializers...>> {
+    using type = std::conditional_t<
+        is_type_complete_v<FirstSerializer<T, void>>,
+        FirstSerializer<T, void>,
+        typename find_serializer<
+            T, serializer_list<OtherSerializers...>>::type>;
+};
+template <typename T, typename SerializerList>
+using find_serializer_t =
+    typename find_serializer<T, SerializerList>::type;
+
+// A serializer for an array or a reflected struct can declare a static
+// data member sequential to be true, to indicate that the serialized form
+// is simply the concatenation of the serialized elements or fields.
+template <typename Serializer, typename = void>
+struct is_sequential_serializer : std::false_type {};
+template <typename Serializer>
+struct is_sequential_serializer<
+    Serializer, std::enable_if_t<Serializer::sequential>>
+    : std::true_type {};
+
+// A serializer can declare a static data member borrows_input to be true,
+// to indicate that a deserialized value refers into the source buffer, like
+// a string_view.  Such a value cannot be deserialized by
+// stream_deserializer, whose source buffer may be its internal buffer.
+template <typename Serializer, typename = void>
+struct is_borrowing_serializer : std::false_type {};
+template <typename Serializer>
+struct is_borrowing_serializer<
+    Serializer, std::enable_if_t<Serializer::borrows_input>>
+    : std::true_type {};
+
+// A serializer for a container can declare a static data member
+// size_prefixed to be true, to indicate that the serialized form is a size
+// prefix followed by the serialized elements.  It shall then provide
+// deserialize_size, to read the size prefix into the container, and
+// deserialize_elements, to append as many of the remaining elements as the
+// input holds.  stream_deserializer uses them to resume such a container
+// between elements.
+template <typename Serializer, typename = void>
+struct is_size_prefixed_serializer : std::false_type {};
+template <typename Serializer>
+struct is_size_prefixed_serializer<
+    Serializer, std::enable_if_t<Serializer::size_prefixed>>
+    : std::true_type {};
+
+// Progress in a size-prefixed container that spans chunks
+struct container_progress {
+    bool size_read{};
+    std::size_t remaining{};
+};
+
+template <typename T, typename SerializerList>
+constexpr bool contains_borrowed_value();
+
+template <typename T, typename SerializerList, std::size_t... Is>
+constexpr bool
+tuple_contains_borrowed_value(std::index_sequence<Is...> /*unused*/)
+{
+    return (contains_borrowed_value<
+                std::remove_cv_t<std::tuple_element_t<Is, T>>,
+                SerializerList>() ||
+            ...);
+}
+
+// Whether a deserialized value of a type, or any of its elements or
+// fields, refers into the source buffer
+template <typename T, typename SerializerList>
+constexpr bool contains_borrowed_value()
+{
+    if constexpr (is_borrowing_serializer<
+                      find_serializer_t<T, SerializerList>>::value) {
+        return true;
+    } else if constexpr (std::is_array_v<T>) {
+        return contains_borrowed_value<
+            std::remove_cv_t<std::remove_extent_t<T>>, SerializerList>();
+    } else if constexpr (is_reflected_struct_v<T>) {
+        bool result = false;
+        for_each_meta<T>([&](auto /*index*/, auto /*name*/, auto type) {
+            using field_type = typename decltype(type)::type;
+            result = result ||
+                     contains_borrowed_value<std::remove_cv_t<field_type>,
+                                             SerializerList>();
+        });
+        return result;
+    } else if constexpr (is_tuple_like_v<T>) {
+        return tuple_contains_borrowed_value<T, SerializerList>(
+            std::make_index_sequence<std::tuple_size<T>::value>{});
+    } else if constexpr (is_container_v<T>) {
+        // Containers and optionals
+        return contains_borrowed_value<
+            std::remove_cv_t<typename T::value_type>, SerializerList>();
+    } else {
+        return false;
+    }
+}
+
+template <typename T>
+struct is_std_array : std::false_type {};
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct array_size;
+template <typename T, std::size_t N>
+struct array_size<T[N]> : std::integral_constant<std::size_t, N> {};
+template <typename T, std::size_t N>
+struct array_size<std::array<T, N>>
+    : std::integral_constant<std::size_t, N> {};
+
+// Number of steps to deserialize a value of a type: sequentially
+// serialized arrays and structs are split into their elements and fields,
+// and other values are deserialized in one step.
+template <typename T, typename SerializerList>
+constexpr std::size_t count_deserialize_steps()
+{
+    if constexpr (!is_sequential_serializer<
+                      find_serializer_t<T, SerializerList>>::value) {
+        return 1;
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+        using element_type =
+            remove_cvref_t<decltype(std::declval<T&>()[0])>;
+        return array_size<T>::value *
+               count_deserialize_steps<element_type, SerializerList>();
+    } else if constexpr (is_reflected_struct_v<T>) {
+        std::size_t result{};
+        for_each_meta<T>([&](auto /*index*/, auto /*name*/, auto type) {
+            using field_type = typename decltype(type)::type;
+            result += count_deserialize_steps<std::remove_cv_t<field_type>,
+                                              SerializerList>();
+        });
+        return result;
+    } else {
+        return 1;
+    }
+}
+
+// Deserializes the elements of a size-prefixed container, continuing
+// from the progress of a previous call
+template <typename Serializer, typename T, typename SerializerList>
+deserialize_result deserialize_container(T& value,
+                                         container_progress& progress,
+                                         deserialize_t& src,
+                                         SerializerList serializers)
+{
+    if (!progress.size_read) {
+        auto result =
+            Serializer::deserialize_size(value, progress.remaining, src);
+        if (result != deserialize_result::success) {
+            return result;
+        }
+        progress.size_read = true;
+    }
+    auto result = Serializer::deserialize_elements(
+        value, progress.remaining, src, serializers);
+    if (result == deserialize_result::success) {
+        progress = {};
+    }
+    return result;
+}
+
+// Deserializes the steps [step, last) of a value, until the input runs
+// out.  On return, step tells the next step to perform, and progress
+// tells how far a size-prefixed container in that step has got.
+template <typename T, typename SerializerList>
+deserialize_result deserialize_steps(T& value, std::size_t& step,
+                                     std::size_t last,
+                                     container_progress& progress,
+                                     deserialize_t& src,
+                                     SerializerList serializers)
+{
+    using serializer_type = find_serializer_t<T, SerializerList>;
+    constexpr auto total = count_deserialize_steps<T, SerializerList>();
+    last = std::min(last, total);
+    if constexpr (is_size_prefixed_serializer<serializer_type>::value) {
+        if (step < last) {
+            // Complete elements are kept even if the input runs out
+            auto result = deserialize_container<serializer_type>(
+                value, progress, src, serializers);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+            step = 1;
+        }
+        return deserialize_result::success;
+    } else if constexpr (!is_sequential_serializer<
+                             serializer_type>::value ||
+                         total == 1) {
+        if (step < last) {
+            auto saved_src = src;
+            auto result = mozi::deserialize(value, src, serializers);
+            if (result != deserialize_result::success) {
+                // Retry from the beginning of the value next time
+                src = saved_src;
+                return result;
+            }
+            step = 1;
+        }
+        return deserialize_result::success;
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+        constexpr auto element_steps = total / array_size<T>::value;
+        while (step < last) {
+            auto i = step / element_steps;
+            auto element_step = step % element_steps;
+            auto result = deserialize_steps(value[i], element_step,
+                                            last - i * element_steps,
+                                            progress, src, serializers);
+            step = i * element_steps + element_step;
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+        return deserialize_result::success;
+    } else {
+        auto result = deserialize_result::success;
+        std::size_t base{};
+        for_each(value, [&](auto /*index*/, auto /*name*/, auto& field) {
+            using field_type = remove_cvref_t<decltype(field)>;
+            constexpr auto field_steps =
+                count_deserialize_steps<field_type, SerializerList>();
+            if (result == deserialize_result::success && step < last &&
+                step < base + field_steps) {
+                auto field_step = step - base;
+                result = deserialize_steps(field, field_step, last - base,
+                                           progress, src, serializers);
+                step = base + field_step;
+            }
+            base += field_steps;
+        });
+        return result;
+    }
+}
+
+} // namespace detail
+
+// Resumable deserializer for input that arrives in chunks, like from a
+// socket.  Each call to feed consumes a chunk and continues from where the
+// previous call stopped.  Arrays and reflected structs whose serializers
+// are sequential (like those of net_pack) are deserialized element by
+// element and field by field.  Size-prefixed containers (like strings,
+// vectors and maps of net_pack) are resumed element by element.  Only the
+// bytes of the element or field that spans chunks are buffered
+// internally.
+//
+// The value to deserialize into must outlive the deserializer.  It shall
+// not contain views into the input, which is checked at compile time, as
+// a view decoded from the internal buffer would dangle.
+template <typename T, typename SerializerList>
+class stream_deserializer {
+public:
+    static_assert(!detail::contains_borrowed_value<T, SerializerList>(),
+                  "Views into the input, like string_view, cannot be "
+                  "deserialized by stream_deserializer");
+
+    static constexpr std::size_t total_steps =
+        detail::count_deserialize_steps<T, SerializerList>();
+
+    explicit stream_deserializer(T& value,
+                                 SerializerList /*serializers*/ = {})
+        : value_(&value)
+    {
+    }
+
+    // Returns success when the value is complete, and input_truncated when
+    // more input is needed.  Consumed bytes are removed from src, so bytes
+    // following the complete value are left there.
+    deserialize_result feed(deserialize_t& src)
+    {
+        if (done()) {
+            return deserialize_result::success;
+        }
+        if (!pending_.empty()) {
+            // Complete the step that spans chunks first
+            auto old_size = pending_.size();
+            pending_.insert(pending_.end(), src.begin(), src.end());
+            deserialize_t input{pending_};
+            auto result = deserialize_some(input, step_ + 1);
+            auto used = pending_.size() - input.size();
+            if (result == deserialize_result::input_truncated) {
+                // Drop the elements of a container already deserialized
+                pending_.erase(pending_.begin(),
+                               pending_.begin() +
+                                   static_cast<std::ptrdiff_t>(used));
+                consumed_ += src.size();
+                src = src.subspan(src.size());
+                return result;
+            }
+            if (used < old_size) {
+                // Keep src unchanged, as the step has failed before
+                // reaching it
+                pending_.erase(pending_.begin(),
+                               pending_.begin() +
+                                   static_cast<std::ptrdiff_t>(used));
+                pending_.resize(old_size - used);
+                return result;
+            }
+            used -= old_size;
+            pending_.clear();
+            consumed_ += used;
+            src = src.subspan(used);
+            if (result != deserialize_result::success) {
+                return result;
+            }
+        }
+        auto size = src.size();
+        auto result = deserialize_some(src, total_steps);
+        consumed_ += size - src.size();
+        if (result == deserialize_result::input_truncated) {
+            pending_.assign(src.begin(), src.end());
+            consumed_ += src.size();
+            src = src.subspan(src.size());
+        }
+        return result;
+    }
+
+    bool done() const
+    {
+        return step_ == total_steps;
+    }
+    std::size_t steps_done() const
+    {
+        return step_;
+    }
+    std::size_t bytes_consumed() const
+    {
+        return consumed_;
+    }
+
+private:
+    deserialize_result deserialize_some(deserialize_t& src,
+                                        std::size_t last)
+    {
+        return detail::deserialize_steps(*value_, step_, last, progress_,
+                                         src, SerializerList{});
+    }
+
+    T* value_;
+    std::size_t step_{};
+    detail::container_progress progress_;
+    std::size_t consumed_{};
+    std::vector<std::byte> pending_;
+};
+
+} // namespace mozi
+
+#endif // MOZI_STREAM_DESERIALIZER_HPP
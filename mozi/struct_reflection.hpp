@@ -27,6 +27,7 @@
 #include "struct_reflection_core.hpp"    // IWYU pragma: export
 #include "struct_reflection_compare.hpp" // IWYU pragma: export
 #include "struct_reflection_copy.hpp"    // IWYU pragma: export
+#include "struct_reflection_hash.hpp"    // IWYU pragma: export
 #include "struct_reflection_print.hpp"   // IWYU pragma: export
 
 #endif // MOZI_STRUCT_REFLECTION_HPP
@@ -24,14 +24,39 @@
 #ifndef MOZI_STRUCT_REFLECTION_EQUAL_HPP
 #define MOZI_STRUCT_REFLECTION_EQUAL_HPP
 
-#include <type_traits>                // std::enable_if
-#include <utility>                    // std::forward
-#include "equal.hpp"                  // mozi::equality_comparer/equal
+#include <cstddef>                    // std::size_t
+#include <cstring>                    // std::memcmp
+#include <type_traits>                // std::enable_if/...
+#include <utility>                    // std::forward/index_sequence/...
+#include "equal.hpp"                  // mozi::equality_comparer/equal/...
 #include "struct_reflection_core.hpp" // mozi::zip
 #include "type_traits.hpp"            // mozi::remove_cvref
 
 namespace mozi {
 
+namespace detail {
+
+template <typename T, std::size_t... Is>
+constexpr bool are_fields_bitwise_comparable(std::index_sequence<Is...>)
+{
+    return (is_bitwise_comparable_v<
+                typename T::template _field<T, Is>::type> &&
+            ...);
+}
+
+} // namespace detail
+
+// A reflected struct without padding, whose fields are all compared
+// bitwise, is itself compared bitwise.
+template <typename T>
+struct is_bitwise_comparable<
+    T, std::enable_if_t<is_reflected_struct_v<T> &&
+                        std::is_trivially_copyable_v<T> &&
+                        std::has_unique_object_representations_v<T> &&
+                        detail::are_fields_bitwise_comparable<T>(
+                            std::make_index_sequence<T::_size>{})>>
+    : std::true_type {};
+
 template <typename T, typename U>
 struct equality_comparer<T, U,
                          std::enable_if_t<is_reflected_struct_v<T> &&
@@ -41,6 +66,11 @@ struct equality_comparer<T, U,
     {
         static_assert(std::is_same_v<mozi::remove_cvref_t<T1>, T> &&
                       std::is_same_v<mozi::remove_cvref_t<U1>, U>);
+        if constexpr (std::is_same_v<T, U> && is_bitwise_comparable_v<T>) {
+            if (!detail::is_constant_evaluated()) {
+                return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+            }
+        }
         if constexpr (T::_size == U::_size) {
             bool result = true;
             zip(std::forward<T1>(lhs), std::forward<U1>(rhs),
@@ -0,0 +1,54 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef MOZI_STRUCT_REFLECTION_HASH_HPP
+#define MOZI_STRUCT_REFLECTION_HASH_HPP
+
+#include <cstddef>                     // std::size_t
+#include <type_traits>                 // std::enable_if
+#include "hash.hpp"                    // mozi::hasher/hash/hash_combine
+#include "struct_reflection_core.hpp"  // mozi::for_each
+#include "struct_reflection_equal.hpp" // mozi::is_bitwise_comparable
+#include "type_traits.hpp"             // mozi::is_reflected_struct
+
+namespace mozi {
+
+// Reflected structs compared bitwise are hashed as raw bytes by the
+// generic hasher; other reflected structs are hashed field by field.
+template <typename T>
+struct hasher<T, std::enable_if_t<is_reflected_struct_v<T> &&
+                                  !is_bitwise_comparable_v<T>>> {
+    std::size_t operator()(const T& obj) const
+    {
+        std::size_t result{};
+        mozi::for_each(
+            obj, [&result](auto /*index*/, auto /*name*/,
+                           const auto& value) {
+                result = hash_combine(result, mozi::hash(value));
+            });
+        return result;
+    }
+};
+
+} // namespace mozi
+
+#endif // MOZI_STRUCT_REFLECTION_HASH_HPP
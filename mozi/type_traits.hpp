@@ -216,6 +216,17 @@ template <typename T>
 inline constexpr static bool is_bit_fields_container_v =
     is_bit_fields_container<T>::value;
 
+// Type trait for bit-fields containers that keep all fields in one word
+template <typename T, typename = void>
+struct is_packed_bit_fields_container : std::false_type {};
+template <typename T>
+struct is_packed_bit_fields_container<
+    T, std::void_t<typename T::is_mozi_packed_bit_fields_container>>
+    : std::true_type {};
+template <typename T>
+inline constexpr static bool is_packed_bit_fields_container_v =
+    is_packed_bit_fields_container<T>::value;
+
 } // namespace mozi
 
 #endif // MOZI_TYPE_TRAITS_HPP
@@ -22,9 +22,16 @@
  */
 
 #include "mozi/bit_fields.hpp"          // mozi::bit_field/...
+#include <atomic>                       // std::memory_order_relaxed
+#include <cstddef>                      // std::size_t
+#include <cstdint>                      // std::int64_t/uint64_t/...
 #include <ios>                          // std::hex
+#include <type_traits>                  // std::is_same
+#include <vector>                       // std::vector
 #include <sstream>                      // std::ostringstream
+#include <thread>                       // std::thread
 #include <catch2/catch_test_macros.hpp> // Catch2 test macros
+#include "mozi/atomic_bit_fields.hpp"   // DEFINE_ATOMIC_BIT_FIELDS_...
 #include "mozi/copy.hpp"                // mozi::copy
 #include "mozi/equal.hpp"               // mozi::equal
 #include "mozi/print.hpp"               // mozi::println
@@ -48,6 +55,48 @@ DEFINE_BIT_FIELDS_CONTAINER(  //
     (mozi::bit_field<12>)f3  //
 );
 
+DEFINE_PACKED_BIT_FIELDS_CONTAINER(                    //
+    PackedDate,                                        //
+    (mozi::bit_field<23, mozi::bit_field_signed>)year, //
+    (mozi::bit_field<4>)month,                         //
+    (mozi::bit_field<5>)day                            //
+);
+
+DEFINE_PACKED_BIT_FIELDS_CONTAINER( //
+    Switches,                       //
+    (mozi::bit_field<1>)s1,         //
+    (mozi::bit_field<1>)s2,         //
+    (mozi::bit_field<1>)s3,         //
+    (mozi::bit_field<1>)s4,         //
+    (mozi::bit_field<1>)s5,         //
+    (mozi::bit_field<1>)s6,         //
+    (mozi::bit_field<1>)s7,         //
+    (mozi::bit_field<1>)s8          //
+);
+
+DEFINE_BIT_FIELDS_CONTAINER(                           //
+    Header,                                            //
+    (mozi::bit_field<4>)version,                       //
+    (mozi::bit_field<12>)length,                       //
+    (mozi::bit_field<40, mozi::bit_field_signed>)time, //
+    (mozi::bit_field<8>)flags                          //
+);
+
+DEFINE_PACKED_BIT_FIELDS_CONTAINER( //
+    Wide,                           //
+    (mozi::bit_field<40>)a,         //
+    (mozi::bit_field<40>)b,         //
+    (mozi::bit_field<16>)c          //
+);
+
+DEFINE_ATOMIC_BIT_FIELDS_CONTAINER(                    //
+    ConnectionStatus,                                  //
+    (mozi::bit_field<1>)readable,                      //
+    (mozi::bit_field<1>)writable,                      //
+    (mozi::bit_field<4>)state,                         //
+    (mozi::bit_field<10, mozi::bit_field_signed>)error //
+);
+
 DEFINE_STRUCT( //
     S1,        //
     (int)v1,   //
@@ -104,6 +153,199 @@ TEST_CASE("bit_fields: basic")
     CHECK(f5 == -4);
 }
 
+TEST_CASE("bit_fields: packed")
+{
+    static_assert(sizeof(Switches) == 1);
+    static_assert(sizeof(PackedDate) == 4);
+
+    Switches sw{};
+    sw.s1() = 1;
+    sw.s8() = 1;
+    sw.s3() = 3; // overflown
+    CHECK(sw._bits == 0b10100001);
+    CHECK(sw.s1() == 1);
+    CHECK(sw.s2() == 0);
+    CHECK(sw.s3() == 1);
+    sw.s2() = sw.s1();
+    sw.s1() = 0;
+    CHECK(sw._bits == 0b01100001);
+
+    PackedDate d = PackedDate::pack(PackedDate::unpacked_type{});
+    CHECK(d._bits == 0);
+    d.year() = -2;
+    d.month() = 12;
+    d.day() = 31;
+    CHECK(d.year() == -2);
+    CHECK(d.month() == 12);
+    CHECK(d.day() == 31);
+    const auto& cd = d;
+    int year = cd.year();
+    CHECK(year == -2);
+
+    Date ud{-2, 12, 31};
+    CHECK(d._bits == mozi::pack_bit_fields(ud));
+    CHECK(PackedDate::pack(d.unpack()) == d);
+    auto ud2 = d.unpack();
+    CHECK(ud2.year == -2);
+    CHECK(ud2.month == 12);
+    CHECK(ud2.day == 31);
+
+    constexpr auto cd2 = [] {
+        PackedDate result{};
+        result.month() = 8;
+        return result;
+    }();
+    static_assert(cd2.month() == 8);
+    static_assert(cd2.year() == 0);
+}
+
+TEST_CASE("bit_fields: 64 bits and more")
+{
+    mozi::bit_field<64> f1{UINT64_MAX};
+    CHECK(f1 == UINT64_MAX);
+    mozi::bit_field<40, mozi::bit_field_signed> f2{-5};
+    CHECK(f2 == -5);
+    f2 = std::int64_t{1} << 39; // overflown
+    CHECK(f2 == -(std::int64_t{1} << 39));
+
+    Header h{{4}, {0xABC}, {-2}, {0x5A}};
+    auto bits = mozi::pack_bit_fields(h);
+    static_assert(std::is_same_v<decltype(bits), std::uint64_t>);
+    CHECK(bits == 0x4ABC'FFFFFFFFFE'5A);
+    Header h2{};
+    mozi::unpack_bit_fields(h2, bits);
+    CHECK(mozi::equal(h, h2));
+    CHECK(h2.time == -2);
+
+    static_assert(sizeof(Wide) == 16);
+    Wide w{};
+    w.a() = 0xFEDCBA9876;
+    w.b() = 0x0123456789;
+    w.c() = 0xFFFF;
+    CHECK(w._bits[1] == 0xFEDCBA98);
+    CHECK(w._bits[0] == 0x76'0123456789'FFFF);
+    CHECK(w.a() == 0xFEDCBA9876);
+    CHECK(w.b() == 0x0123456789);
+    CHECK(w.c() == 0xFFFF);
+    w.a() = 0;
+    CHECK(w._bits[1] == 0);
+    CHECK(w._bits[0] == 0x00'0123456789'FFFF);
+    auto uw = w.unpack();
+    CHECK(uw.b == 0x0123456789);
+    CHECK(Wide::pack(uw) == w);
+}
+
+TEST_CASE("bit_fields: bulk pack and unpack")
+{
+    std::vector<Date> dates;
+    for (int i = 0; i < 1000; ++i) {
+        dates.push_back(
+            Date{i * 7 - 3000, static_cast<unsigned>(i % 12 + 1),
+                 static_cast<unsigned>(i % 31 + 1)});
+    }
+    std::vector<std::uint32_t> bits(dates.size());
+    mozi::pack_bit_fields(dates.data(), dates.size(), bits.data());
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+        REQUIRE(bits[i] == mozi::pack_bit_fields(dates[i]));
+    }
+
+    std::vector<Date> dates2(dates.size());
+    mozi::unpack_bit_fields(dates2.data(), dates2.size(), bits.data());
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+        REQUIRE(dates2[i] == dates[i]);
+    }
+    CHECK(dates2[0].year == -3000);
+}
+
+TEST_CASE("bit_fields: atomic")
+{
+    static_assert(sizeof(ConnectionStatus) == 2);
+    static_assert(ConnectionStatus::is_always_lock_free);
+
+    ConnectionStatus status;
+    CHECK(status.load()._bits == 0);
+    status.readable() = 1;
+    status.state() = 5;
+    status.error().store(-3, std::memory_order_relaxed);
+    CHECK(status.readable() == 1);
+    CHECK(status.writable() == 0);
+    CHECK(status.state() == 5);
+    CHECK(status.error().load(std::memory_order_relaxed) == -3);
+    CHECK(status.state().exchange(6) == 5);
+    CHECK(status.readable().exchange(0) == 1);
+    CHECK(status.readable() == 0);
+
+    unsigned expected = 5;
+    CHECK_FALSE(status.state().compare_exchange_strong(expected, 7));
+    CHECK(expected == 6);
+    CHECK(status.state().compare_exchange_strong(expected, 7));
+    CHECK(status.state() == 7);
+    CHECK(status.error() == -3);
+
+    int expected_error = 3;
+    CHECK_FALSE(status.error().compare_exchange_strong(expected_error, -5));
+    CHECK(expected_error == -3);
+    CHECK(status.error().compare_exchange_strong(expected_error, -5));
+    CHECK(status.error() == -5);
+    CHECK(status.state() == 7);
+    status.error() = -3;
+
+    const auto& cstatus = status;
+    auto value = cstatus.load();
+    CHECK(value.state() == 7);
+    auto unpacked = value.unpack();
+    CHECK(unpacked.error == -3);
+
+    auto old_value = status.update([](auto& v) {
+        v.writable() = 1;
+        v.state() = v.state() + 1;
+        v.error() = 0;
+    });
+    CHECK(old_value == value);
+    CHECK(status.writable() == 1);
+    CHECK(status.state() == 8);
+    CHECK(status.error() == 0);
+
+    ConnectionStatus::packed_type desired = status.load();
+    desired.readable() = 1;
+    CHECK_FALSE(status.compare_exchange_strong(old_value, desired));
+    CHECK(old_value == status.load());
+    CHECK(status.compare_exchange_strong(old_value, desired));
+    CHECK(status.readable() == 1);
+
+    unpacked.state = 2;
+    ConnectionStatus status2{unpacked};
+    CHECK(status2.state() == 2);
+    CHECK(status2.error() == -3);
+    CHECK(status2.exchange(status.load()).state() == 2);
+    CHECK(status2.load() == status.load());
+}
+
+TEST_CASE("bit_fields: atomic concurrent")
+{
+    // Neither the field stores nor the updates may lose the other
+    // thread's changes to the same word
+    ConnectionStatus status;
+    status.error() = -250;
+    std::thread updater([&status] {
+        for (int i = 0; i < 500; ++i) {
+            status.update([](auto& v) { v.error() = v.error() + 1; });
+        }
+    });
+    std::thread storer([&status] {
+        for (unsigned i = 0; i < 1000; ++i) {
+            status.writable() = i % 2;
+            status.state() = i % 16;
+        }
+    });
+    updater.join();
+    storer.join();
+    CHECK(status.readable() == 0);
+    CHECK(status.writable() == 1);
+    CHECK(status.state() == 7);
+    CHECK(status.error() == 250);
+}
+
 TEST_CASE("bit_fields: print")
 {
     std::ostringstream oss;
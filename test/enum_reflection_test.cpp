@@ -21,13 +21,18 @@
  *
  */
 
-#include "mozi/enum_reflection.hpp"     // DEFINE_ENUM/DEFINE_ENUM_CLASS
+#include "mozi/enum_reflection.hpp"     // DEFINE_ENUM/DEFINE_ENUM_CLASS/...
+#include <cstdint>                      // std::int64_t/INT64_MIN/...
 #include <sstream>                      // std::ostringstream
+#include <stdexcept>                    // std::out_of_range
+#include <string>                       // std::string
+#include <string_view>                  // std::string_view
 #include <tuple>                        // std::tuple
 #include <type_traits>                  // std::is_enum
 #include <vector>                       // std::vector
 #include <stdint.h>                     // uint8_t
 #include <catch2/catch_test_macros.hpp> // Catch2 test macros
+#include "mozi/enum_containers.hpp"     // mozi::enum_array/enum_set
 #include "mozi/print.hpp"               // mozi::print
 #include "mozi/type_traits.hpp"         // mozi::is_reflected_enum
 
@@ -41,6 +46,28 @@ DEFINE_ENUM_CLASS(  //
     Color, uint8_t, //
     red = 1, highlight = Color::red, green, blue);
 
+DEFINE_ENUM_CLASS( //
+    Level, int,    //
+    low = -1000, normal = 0, high = 1000000);
+
+DEFINE_ENUM_CLASS(     //
+    Id, std::uint64_t, //
+    none = 0, invalid = UINT64_MAX);
+
+DEFINE_ENUM_CLASS(         //
+    Extreme, std::int64_t, //
+    lo = INT64_MIN, hi = INT64_MAX);
+
+DEFINE_ENUM_CLASS(                                                     //
+    Letter, char,                                                     //
+    a = 'a', b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, //
+    u, v, w, x, y, z);
+
+DEFINE_FLAGS_ENUM(                                            //
+    Permission, uint8_t,                                     //
+    none = 0, read = 1, write = 2, exec = 4, read_write = 3, //
+    admin = 0x80);
+
 enum class Number { zero, one, two, three };
 
 } // unnamed namespace
@@ -111,6 +138,240 @@ TEST_CASE("enum_reflection: enum class")
         REQUIRE(from_string("highlight", color));
         CHECK(color == Color::highlight);
     }
+
+    SECTION("to_string_view", "converts enumerator without allocation")
+    {
+        static_assert(to_string_view(Color::highlight) == "red");
+        static_assert(to_string_view(Color::blue,
+                                     enum_to_string::show_name) ==
+                      "Color::blue");
+        static_assert(to_string_view(Color{9}).empty());
+        CHECK(to_string_view(CHANNEL_ALPHA, enum_to_string::show_name) ==
+              "Channel::CHANNEL_ALPHA");
+    }
+
+    SECTION("to_string with buffer", "appends to a string")
+    {
+        std::string buffer = "color: ";
+        to_string(Color::green, buffer, enum_to_string::show_name);
+        buffer += ", ";
+        to_string(Color{9}, buffer);
+        buffer += ", ";
+        to_string(Level{-1}, buffer);
+        CHECK(buffer == "color: Color::green, (Color)9, (Level)-1");
+    }
+
+    SECTION("constexpr", "lookups in constant expressions")
+    {
+        static_assert(is_defined(Color::blue));
+        static_assert(!is_defined(Color{9}));
+        static_assert(mozi::detail::enum_tables<Color>::value_count == 3);
+        constexpr auto parsed = [] {
+            Color result{};
+            from_string("green", result);
+            return result;
+        }();
+        static_assert(parsed == Color::green);
+    }
+}
+
+TEST_CASE("enum_reflection: sparse enum")
+{
+    static_assert(mozi::detail::enum_tables<Color>::is_dense);
+    static_assert(!mozi::detail::enum_tables<Level>::is_dense);
+
+    CHECK(is_defined(Level::low));
+    CHECK(is_defined(Level::high));
+    CHECK_FALSE(is_defined(Level{1}));
+    CHECK_FALSE(is_defined(Level{-1001}));
+    CHECK(to_string(Level::high) == "high");
+    CHECK(to_string(Level{-1}) == "(Level)-1");
+
+    // Values covering the whole 64-bit range
+    static_assert(!mozi::detail::enum_tables<Id>::is_dense);
+    static_assert(!mozi::detail::enum_tables<Extreme>::is_dense);
+    CHECK(is_defined(Id::none));
+    CHECK(is_defined(Id::invalid));
+    CHECK_FALSE(is_defined(Id{1}));
+    CHECK(to_string(Id::invalid) == "invalid");
+    CHECK(is_defined(Extreme::lo));
+    CHECK(is_defined(Extreme::hi));
+    CHECK_FALSE(is_defined(Extreme{0}));
+    CHECK(to_string(Extreme::lo) == "lo");
+    CHECK(to_string(Extreme{0}) == "(Extreme)0");
+}
+
+TEST_CASE("enum_reflection: from_string")
+{
+    static_assert(mozi::detail::enum_tables<Color>::name_hash_table.valid);
+    static_assert(mozi::detail::enum_tables<Letter>::name_hash_table.valid);
+
+    Letter letter{};
+    for (char ch = 'a'; ch <= 'z'; ++ch) {
+        REQUIRE(from_string(std::string_view(&ch, 1), letter));
+        CHECK(letter == Letter{ch});
+    }
+    CHECK_FALSE(from_string("", letter));
+    CHECK_FALSE(from_string("A", letter));
+    CHECK_FALSE(from_string("ab", letter));
+
+    Color color{};
+    CHECK_FALSE(from_string("blu", color));
+    CHECK_FALSE(from_string("bluee", color));
+    CHECK(color == Color{});
+}
+
+TEST_CASE("enum_reflection: enumerator iteration")
+{
+    SECTION("values", "distinct values in constant expressions")
+    {
+        static_assert(mozi::enum_count<Color>() == 3);
+        static_assert(mozi::enum_min<Color>() == Color::red);
+        static_assert(mozi::enum_max<Color>() == Color::blue);
+        static_assert(mozi::enum_values<Color>()[1] == Color::green);
+        static_assert(mozi::enum_min<Level>() == Level::low);
+        static_assert(mozi::enum_max<Level>() == Level::high);
+
+        std::string result;
+        for (auto level : mozi::enum_values<Level>()) {
+            result += to_string(level);
+            result += ' ';
+        }
+        CHECK(result == "low normal high ");
+    }
+
+    SECTION("enum_switch", "dispatches on enumerator constants")
+    {
+        auto scale = [](auto level) {
+            constexpr Level value = decltype(level)::value;
+            static_assert(is_defined(value));
+            return value == Level::high ? 100 : 1;
+        };
+        static_assert(mozi::enum_switch(Level::high, scale) == 100);
+        CHECK(mozi::enum_switch(Level::low, scale) == 1);
+        CHECK(mozi::enum_switch(Level{7}, scale) == 0);
+        CHECK(mozi::enum_switch(Level{7}, scale, [](Level value) {
+                  return mozi::to_underlying(value);
+              }) == 7);
+
+        std::string name;
+        mozi::enum_switch(Color::blue, [&name](auto color) {
+            name = to_string_view(decltype(color)::value);
+        });
+        CHECK(name == "blue");
+    }
+}
+
+TEST_CASE("enum_reflection: containers")
+{
+    SECTION("enum_array", "array indexed by enumerator")
+    {
+        mozi::enum_array<Level, int> counts;
+        static_assert(decltype(counts)::size() == 3);
+        counts[Level::high] = 2;
+        counts.at(Level::low) += 1;
+        CHECK(counts[Level::low] == 1);
+        CHECK(counts[Level::normal] == 0);
+        CHECK(counts[Level::high] == 2);
+        CHECK(decltype(counts)::key(2) == Level::high);
+        CHECK_THROWS_AS(counts.at(Level{1}), std::out_of_range);
+
+        mozi::enum_array<Color, std::string> names;
+        static_assert(decltype(names)::size() == 3);
+        names[Color::green] = "green";
+        CHECK(names[Color::green] == "green");
+        CHECK(&names[Color::highlight] == &names[Color::red]);
+    }
+
+    SECTION("enum_set", "bitset of enumerators")
+    {
+        constexpr mozi::enum_set<Level> levels{Level::low, Level::high};
+        static_assert(levels.contains(Level::low));
+        static_assert(!levels.contains(Level::normal));
+        static_assert(levels.size() == 2);
+
+        mozi::enum_set<Letter> letters{Letter::z, Letter::a, Letter{'?'}};
+        CHECK(letters.size() == 2);
+        CHECK_FALSE(letters.contains(Letter{'?'}));
+        letters.insert(Letter::m);
+        letters.erase(Letter::a);
+        std::string result;
+        for (auto letter : letters) {
+            result += static_cast<char>(letter);
+        }
+        CHECK(result == "mz");
+
+        mozi::enum_set<Letter> other{Letter::m, Letter::b};
+        CHECK((letters & other) == mozi::enum_set<Letter>{Letter::m});
+        CHECK((letters | other).size() == 3);
+        letters.clear();
+        CHECK(letters.empty());
+        CHECK(letters.begin() == letters.end());
+    }
+}
+
+TEST_CASE("enum_reflection: flags enum")
+{
+    using P = Permission;
+
+    SECTION("operators", "bitwise operators")
+    {
+        static_assert((P::read | P::write) == P::read_write);
+        static_assert((P::read_write & P::write) == P::write);
+        static_assert((P::read_write ^ P::read) == P::write);
+        static_assert((~P::read & P::read_write) == P::write);
+        P perm = P::read;
+        perm |= P::exec;
+        perm &= ~P::read;
+        perm ^= P::admin;
+        CHECK(perm == (P::exec | P::admin));
+    }
+
+    SECTION("is_defined", "check defined flags")
+    {
+        static_assert(is_defined(P::none));
+        static_assert(is_defined(P::exec | P::admin));
+        static_assert(!is_defined(P{0x10}));
+        static_assert(!is_defined(P::read | P{0x10}));
+    }
+
+    SECTION("to_string", "converts flags to string")
+    {
+        CHECK(to_string(P::none) == "none");
+        CHECK(to_string(P::read_write) == "read_write");
+        CHECK(to_string(P::read | P::exec | P::admin) == "read|exec|admin");
+        CHECK(to_string(P::exec | P::write, enum_to_string::show_name) ==
+              "Permission::write|Permission::exec");
+        CHECK(to_string(P::exec | P{0x30}) == "exec|(Permission)48");
+        CHECK(to_string(P{0x10}) == "(Permission)16");
+
+        // Only single enumerators have names without allocation
+        static_assert(to_string_view(P::read_write) == "read_write");
+        static_assert(is_defined(P::read | P::exec));
+        static_assert(to_string_view(P::read | P::exec).empty());
+    }
+
+    SECTION("from_string", "parses list of flags")
+    {
+        P perm{};
+        REQUIRE(from_string("read|admin", perm));
+        CHECK(perm == (P::read | P::admin));
+        REQUIRE(from_string(" exec | read_write ", perm));
+        CHECK(perm == (P::exec | P::read_write));
+        REQUIRE(from_string("none", perm));
+        CHECK(perm == P::none);
+        CHECK_FALSE(from_string("read|", perm));
+        CHECK_FALSE(from_string("read|delete", perm));
+        CHECK_FALSE(from_string("", perm));
+        CHECK(perm == P::none);
+    }
+
+    SECTION("print", "prints flags")
+    {
+        std::ostringstream oss;
+        mozi::print(P::read | P::exec, oss);
+        CHECK(oss.str() == "Permission::read|Permission::exec");
+    }
 }
 
 TEST_CASE("enum_reflection: reflected?")
@@ -23,9 +23,50 @@
 
 #include "mozi/equal.hpp"               // mozi::equal
 #include <array>                        // std::array
+#include <cstdint>                      // std::uint8_t
 #include <string_view>                  // std::string_view
+#include <type_traits>                  // std::false_type
 #include <vector>                       // std::vector
 #include <catch2/catch_test_macros.hpp> // Catch2 test macros
+#include "mozi/span.hpp"                // mozi::span
+#include "mozi/struct_reflection.hpp"   // DEFINE_STRUCT
+
+namespace {
+
+DEFINE_STRUCT(    //
+    Sample,       //
+    (int)id,      //
+    (unsigned)seq //
+);
+
+DEFINE_STRUCT(  //
+    Reading,    //
+    (int)id,    //
+    (double)val //
+);
+
+// Severities in the same group of 16 are equal
+enum class Severity : std::uint8_t {};
+
+DEFINE_STRUCT(          //
+    Event,              //
+    (Severity)severity, //
+    (std::uint8_t)code  //
+);
+
+} // unnamed namespace
+
+template <>
+struct mozi::equality_comparer<Severity, Severity> {
+    constexpr bool operator()(Severity lhs, Severity rhs) const
+    {
+        return static_cast<unsigned>(lhs) / 16 ==
+               static_cast<unsigned>(rhs) / 16;
+    }
+};
+
+template <>
+struct mozi::is_bitwise_comparable<Severity> : std::false_type {};
 
 TEST_CASE("equal")
 {
@@ -59,5 +100,56 @@ TEST_CASE("equal")
         CHECK(mozi::equal(a3, a4));
         a3[0] = 0;
         CHECK_FALSE(mozi::equal(a3, a4));
+
+        constexpr int a5[]{1, 2, 3};
+        constexpr int a6[]{1, 2, 4};
+        static_assert(!mozi::equal(a5, a6));
+
+        double d1[]{0.0, 1.0};
+        double d2[]{-0.0, 1.0};
+        CHECK(mozi::equal(d1, d2));
+    }
+
+    SECTION("spans")
+    {
+        std::vector v1{1, 2, 3, 4, 5};
+        std::vector v2 = v1;
+        mozi::span<const int> s1{v1};
+        mozi::span<int> s2{v2};
+        CHECK(mozi::equal(s1, s2));
+        CHECK_FALSE(mozi::equal(s1, s2.first(4)));
+        CHECK(mozi::equal(s1.first(0), s2.first(0)));
+        v2[4] = 0;
+        CHECK_FALSE(mozi::equal(s1, s2));
+    }
+
+    SECTION("reflected structs")
+    {
+        static_assert(mozi::is_bitwise_comparable_v<Sample>);
+        static_assert(mozi::is_bitwise_comparable_v<Sample[2]>);
+        static_assert(!mozi::is_bitwise_comparable_v<Reading>);
+
+        Sample s1[]{{1, 2}, {3, 4}};
+        Sample s2[]{{1, 2}, {3, 4}};
+        CHECK(mozi::equal(s1, s2));
+        s2[1].seq = 5;
+        CHECK_FALSE(mozi::equal(s1, s2));
+        CHECK(mozi::equal(s1[0], s2[0]));
+        static_assert(mozi::equal(Sample{1, 2}, Sample{1, 2}));
+
+        Reading r1{1, 0.0};
+        Reading r2{1, -0.0};
+        CHECK(mozi::equal(r1, r2));
+
+        // The comparer of a type not compared bitwise is honoured
+        static_assert(!mozi::is_bitwise_comparable_v<Event>);
+        Event e1{Severity{0x21}, 1};
+        Event e2{Severity{0x2F}, 1};
+        Event e3{Severity{0x31}, 1};
+        CHECK(mozi::equal(e1, e2));
+        CHECK_FALSE(mozi::equal(e1, e3));
+        Severity sv1[]{Severity{1}, Severity{0x12}};
+        Severity sv2[]{Severity{2}, Severity{0x13}};
+        CHECK(mozi::equal(sv1, sv2));
     }
 }
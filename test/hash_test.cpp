@@ -0,0 +1,170 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+ * NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+ * USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "mozi/hash.hpp"                // mozi::hash/hasher
+#include <array>                        // std::array
+#include <cstddef>                      // std::size_t
+#include <cstdint>                      // std::uint8_t
+#include <map>                          // std::map
+#include <set>                          // std::set
+#include <string>                       // std::string
+#include <tuple>                        // std::tuple
+#include <unordered_map>                // std::unordered_map
+#include <unordered_set>                // std::unordered_set
+#include <utility>                      // std::pair
+#include <vector>                       // std::vector
+#include <catch2/catch_test_macros.hpp> // Catch2 test macros
+#include "mozi/struct_reflection.hpp"   // DEFINE_STRUCT/...
+
+namespace {
+
+DEFINE_STRUCT( //
+    Point,     //
+    (int)x,    //
+    (int)y     //
+);
+
+DECLARE_EQUAL_COMPARISON(Point);
+
+DEFINE_STRUCT(               //
+    Person,                  //
+    (std::string)name,       //
+    (std::uint8_t)age,       //
+    (std::vector<Point>)path //
+);
+
+DECLARE_EQUAL_COMPARISON(Person);
+
+DEFINE_STRUCT( //
+    Padded,    //
+    (char)c,   //
+    (int)i     //
+);
+
+} // unnamed namespace
+
+TEST_CASE("hash")
+{
+    SECTION("traits")
+    {
+        static_assert(mozi::is_bitwise_comparable_v<int>);
+        static_assert(mozi::is_bitwise_comparable_v<int[3]>);
+        static_assert(mozi::is_bitwise_comparable_v<std::array<char, 5>>);
+        static_assert(!mozi::is_bitwise_comparable_v<double>);
+        static_assert(mozi::is_bitwise_comparable_v<Point>);
+        static_assert(!mozi::is_bitwise_comparable_v<Person>);
+        static_assert(!mozi::is_bitwise_comparable_v<Padded>);
+    }
+
+    SECTION("scalars")
+    {
+        CHECK(mozi::hash(42) == mozi::hash(42));
+        CHECK(mozi::hash(42) != mozi::hash(43));
+        CHECK(mozi::hash(1.0) == mozi::hash(1.0));
+        CHECK(mozi::hash(0.0) == mozi::hash(-0.0));
+
+        // Consecutive integers shall not hash to consecutive values
+        std::unordered_set<std::size_t> low_bits;
+        for (int i = 0; i < 256; ++i) {
+            low_bits.insert(mozi::hash(i * 1024) & 0xFF);
+        }
+        CHECK(low_bits.size() > 128);
+    }
+
+    SECTION("bytes")
+    {
+        // Inputs of all sizes around the word and lane boundaries
+        std::vector<std::uint8_t> data;
+        std::unordered_set<std::size_t> hashes;
+        for (int i = 0; i < 100; ++i) {
+            hashes.insert(mozi::hash(data));
+            auto copy = data;
+            CHECK(mozi::hash(copy) == mozi::hash(data));
+            if (!copy.empty()) {
+                copy.back() ^= 1;
+                CHECK(mozi::hash(copy) != mozi::hash(data));
+            }
+            data.push_back(static_cast<std::uint8_t>(i * 7));
+        }
+        CHECK(hashes.size() == 100);
+    }
+
+    SECTION("containers")
+    {
+        std::string s1 = "hello";
+        std::string s2 = "hello";
+        CHECK(mozi::hash(s1) == mozi::hash(s2));
+        CHECK(mozi::hash(s1) != mozi::hash(std::string("hellp")));
+
+        std::vector<std::string> v1{"a", "b"};
+        std::vector<std::string> v2{"b", "a"};
+        CHECK(mozi::hash(v1) != mozi::hash(v2));
+
+        std::map<std::string, int> m1{{"a", 1}, {"b", 2}};
+        auto m2 = m1;
+        CHECK(mozi::hash(m1) == mozi::hash(m2));
+        m2["b"] = 3;
+        CHECK(mozi::hash(m1) != mozi::hash(m2));
+
+        std::unordered_set<int> us1;
+        std::unordered_set<int> us2(100);
+        for (int i = 0; i < 50; ++i) {
+            us1.insert(i);
+            us2.insert(49 - i);
+        }
+        CHECK(mozi::hash(us1) == mozi::hash(us2));
+
+        std::pair<int, std::string> p{1, "x"};
+        CHECK(mozi::hash(p) ==
+              mozi::hash(std::tuple<int, std::string>{1, "x"}));
+        CHECK(mozi::hash(std::set<int>{1, 2}) !=
+              mozi::hash(std::set<int>{1, 2, 3}));
+    }
+
+    SECTION("reflected structs")
+    {
+        Point pt1{1, 2};
+        Point pt2{1, 2};
+        Point pt3{2, 1};
+        CHECK(mozi::hash(pt1) == mozi::hash(pt2));
+        CHECK(mozi::hash(pt1) != mozi::hash(pt3));
+
+        Person p1{"Alice", 30, {pt1, pt3}};
+        Person p2 = p1;
+        CHECK(mozi::hash(p1) == mozi::hash(p2));
+        p2.age = 31;
+        CHECK(mozi::hash(p1) != mozi::hash(p2));
+
+        Padded pd{'a', 1};
+        CHECK(mozi::hash(pd) == mozi::hash(Padded{'a', 1}));
+
+        std::unordered_map<Person, int, mozi::hasher<Person>> m;
+        m[p1] = 1;
+        m[p2] = 2;
+        CHECK(m.size() == 2);
+        CHECK(m[p1] == 1);
+        std::unordered_set<std::vector<Point>,
+                           mozi::hasher<std::vector<Point>>>
+            paths;
+        paths.insert(p1.path);
+        CHECK(paths.count({pt1, pt3}) == 1);
+    }
+}
@@ -22,19 +22,33 @@
  */
 
 #include "mozi/serialization.hpp"       // mozi::serialize/deserialize/...
+#include <algorithm>                    // std::min
 #include <array>                        // std::array/begin/end
 #include <cstddef>                      // std::size_t/byte
-#include <cstdint>                      // std::uint8_t/uint16_t/uint32_t
-#include <cstring>                      // std::memcpy
+#include <cstdint>                      // std::uint8_t/int16_t/...
+#include <cstring>                      // std::memcpy/memcmp
+#include <map>                          // std::map/multimap
+#include <optional>                     // std::optional/nullopt
 #include <stdexcept>                    // std::runtime_error
+#include <string>                       // std::string/to_string
+#include <string_view>                  // std::string_view
 #include <tuple>                        // std::tuple
 #include <type_traits>                  // std::is_standard_layout/...
+#include <utility>                      // std::pair
+#include <vector>                       // std::vector
 #include <catch2/catch_test_macros.hpp> // Catch2 test macros
 #include "mozi/bit_fields.hpp"          // mozi::bit_field/...
+#include "mozi/bit_pack.hpp"            // mozi::bit_pack::*
+#include "mozi/compact_pack.hpp"        // mozi::compact_pack::*
+#include "mozi/enum_reflection.hpp"     // DEFINE_ENUM_CLASS/...
 #include "mozi/equal.hpp"               // mozi::equal
+#include "mozi/host_pack.hpp"           // mozi::host_pack::*
 #include "mozi/net_pack.hpp"            // mozi::net_pack::*
+#include "mozi/serialize_buffer.hpp"    // mozi::buffer_sink/...
 #include "mozi/span.hpp"                // mozi::span
+#include "mozi/stream_deserializer.hpp" // mozi::stream_deserializer
 #include "mozi/struct_reflection.hpp"   // DEFINE_STRUCT
+#include "mozi/type_traits.hpp"         // mozi::is_type_complete
 
 #if MOZI_SERIALIZATION_USES_PMR == 1
 #include <memory_resource>              // std::pmr::*
@@ -44,6 +58,16 @@ using mozi::deserialize_result;
 
 namespace {
 
+template <typename T>
+auto make_byte_span(const T* ptr, std::size_t size)
+{
+    return mozi::span(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const std::byte*>(ptr),
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const std::byte*>(ptr + size));
+}
+
 template <typename T, std::size_t N>
 auto make_byte_span(const T (&a)[N])
 {
@@ -75,6 +99,27 @@ DEFINE_BIT_FIELDS_CONTAINER( //
     (mozi::bit_field<12>)f3  //
 );
 
+DEFINE_PACKED_BIT_FIELDS_CONTAINER( //
+    PackedFlags32,                  //
+    (mozi::bit_field<3>)f1,         //
+    (mozi::bit_field<17>)f2,        //
+    (mozi::bit_field<12>)f3         //
+);
+
+DEFINE_BIT_FIELDS_CONTAINER(      //
+    Header48,                     //
+    (mozi::bit_field<4>)version,  //
+    (mozi::bit_field<12>)length,  //
+    (mozi::bit_field<32>)sequence //
+);
+
+DEFINE_PACKED_BIT_FIELDS_CONTAINER( //
+    Wide96,                         //
+    (mozi::bit_field<40>)a,         //
+    (mozi::bit_field<40>)b,         //
+    (mozi::bit_field<16>)c          //
+);
+
 DEFINE_STRUCT(        //
     S1,               //
     (int)v1,          //
@@ -100,6 +145,72 @@ DEFINE_STRUCT(               //
     (bool)flag               //
 );
 
+DEFINE_STRUCT(                               //
+    Message,                                 //
+    (std::uint16_t)type,                     //
+    (std::string_view)name,                  //
+    (mozi::span<const std::byte>)payload     //
+);
+
+using uint16_array_2 = std::uint16_t[2];
+
+DEFINE_STRUCT(              //
+    Point,                  //
+    (std::int32_t)x,        //
+    (std::int32_t)y,        //
+    (uint16_array_2)extra   //
+);
+
+using id_pair = std::pair<std::uint8_t, std::uint16_t>;
+using name_map = std::map<std::string, std::uint8_t>;
+
+DEFINE_STRUCT(                           //
+    Record,                              //
+    (std::string)name,                   //
+    (std::vector<std::uint16_t>)values,  //
+    (std::vector<std::uint8_t>)data,     //
+    (std::optional<std::uint8_t>)level,  //
+    (std::optional<std::uint8_t>)weight, //
+    (id_pair)ids,                        //
+    (name_map)index                      //
+);
+
+DEFINE_ENUM_CLASS(       //
+    Mode, std::uint16_t, //
+    idle = 1, run = 2, halt = 5);
+
+DEFINE_ENUM_CLASS(          //
+    RawMode, std::uint16_t, //
+    idle = 1, run = 2, halt = 5);
+
+DEFINE_ENUM_CLASS(         //
+    Handle, std::uint64_t, //
+    null = 0, invalid = UINT64_MAX);
+
+DEFINE_FLAGS_ENUM(        //
+    Access, std::uint8_t, //
+    read = 1, write = 2);
+
+DEFINE_STRUCT(      //
+    Command,        //
+    (Mode)mode,     //
+    (Access)access  //
+);
+
+DEFINE_BIT_FIELDS_CONTAINER(                         //
+    Tag,                                             //
+    (mozi::bit_field<3>)kind,                        //
+    (mozi::bit_field<2, mozi::bit_field_signed>)delta //
+);
+
+DEFINE_STRUCT(              //
+    Frame,                  //
+    (bool)valid,            //
+    (Tag)tag,               //
+    (std::uint16_t)id,      //
+    (std::array<Tag, 2>)more //
+);
+
 template <typename T, typename = void>
 struct naive_serializer {
     static_assert(std::is_standard_layout_v<T> &&
@@ -183,6 +294,13 @@ struct naive_numbered_serializer {
 
 } // unnamed namespace
 
+template <>
+struct mozi::net_pack::validate_enum<Mode> : std::true_type {};
+template <>
+struct mozi::net_pack::validate_enum<Access> : std::true_type {};
+template <>
+struct mozi::net_pack::validate_enum<Handle> : std::true_type {};
+
 TEST_CASE("serialization: net_pack")
 {
     using mozi::net_pack::serialize;
@@ -259,7 +377,851 @@ TEST_CASE("serialization: net_pack")
         REQUIRE(ec == deserialize_result::success);
         CHECK(input.empty());
         CHECK(mozi::equal(data, data2));
+
+        auto packed =
+            PackedFlags32::pack({{1}, {0x1FFFF}, {0b101010101010}});
+        CHECK(serialize(packed) == serialize(data.v4));
+        input = mozi::deserialize_t{result}.subspan(5);
+        PackedFlags32 packed2{};
+        ec = deserialize(packed2, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(packed2 == packed);
+        CHECK(packed2.f2() == 0x1FFFF);
+    }
+
+    SECTION("bit fields in bulk")
+    {
+        std::vector<Flags16> flags;
+        std::vector<PackedFlags32> packed_flags(300);
+        for (unsigned i = 0; i < 300; ++i) {
+            flags.push_back(Flags16{{i % 32}, {i * 5}});
+            packed_flags[i].f1() = i;
+            packed_flags[i].f2() = i * 433;
+            packed_flags[i].f3() = i * 13;
+        }
+        auto result = serialize(flags);
+        REQUIRE(result.size() == 4 + 600);
+        for (std::size_t i = 0; i < flags.size(); ++i) {
+            auto bytes = serialize(flags[i]);
+            REQUIRE(result[4 + i * 2] == bytes[0]);
+            REQUIRE(result[5 + i * 2] == bytes[1]);
+        }
+        mozi::deserialize_t input{result};
+        std::vector<Flags16> flags2;
+        REQUIRE(deserialize(flags2, input) == deserialize_result::success);
+        REQUIRE(flags2.size() == flags.size());
+        for (std::size_t i = 0; i < flags.size(); ++i) {
+            REQUIRE(mozi::equal(flags[i], flags2[i]));
+        }
+
+        result = serialize(packed_flags);
+        REQUIRE(result.size() == 4 + 1200);
+        auto bytes = serialize(packed_flags[299]);
+        CHECK(mozi::serialize_t(result.end() - 4, result.end()) == bytes);
+        input = mozi::deserialize_t{result};
+        std::vector<PackedFlags32> packed_flags2;
+        REQUIRE(deserialize(packed_flags2, input) ==
+                deserialize_result::success);
+        CHECK(packed_flags2 == packed_flags);
+    }
+
+    SECTION("wide bit fields")
+    {
+        static_assert(mozi::net_pack::serialized_size<Header48>() == 6);
+        Header48 header{{4}, {0x123}, {0x89ABCDEF}};
+        auto result = serialize(header);
+        std::uint8_t expected_result[]{0x41, 0x23, 0x89, 0xab, 0xcd, 0xef};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+        mozi::deserialize_t input{result};
+        Header48 header2{};
+        REQUIRE(deserialize(header2, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(mozi::equal(header, header2));
+        input = mozi::deserialize_t{result}.first(5);
+        CHECK(deserialize(header2, input) ==
+              deserialize_result::input_truncated);
+
+        static_assert(mozi::net_pack::serialized_size<Wide96>() == 12);
+        Wide96 wide{};
+        wide.a() = 0xFEDCBA9876;
+        wide.b() = 0x0123456789;
+        wide.c() = 0xABCD;
+        result = serialize(wide);
+        std::uint8_t expected_result2[]{0xfe, 0xdc, 0xba, 0x98,
+                                        0x76, 0x01, 0x23, 0x45,
+                                        0x67, 0x89, 0xab, 0xcd};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result2)));
+        input = mozi::deserialize_t{result};
+        Wide96 wide2{};
+        REQUIRE(deserialize(wide2, input) == deserialize_result::success);
+        CHECK(wide2 == wide);
+    }
+
+    SECTION("views")
+    {
+        std::uint8_t payload[]{0xDE, 0xAD, 0xBE, 0xEF};
+        Message msg{0x0102, "Hello", make_byte_span(payload)};
+        auto result = serialize(msg);
+        std::uint8_t expected_result[]{0x01, 0x02, 0x00, 0x00, 0x00, 0x05,
+                                       'H',  'e',  'l',  'l',  'o',  0x00,
+                                       0x00, 0x00, 0x04, 0xDE, 0xAD, 0xBE,
+                                       0xEF};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::deserialize_t input{result};
+        Message msg2{};
+        auto ec = deserialize(msg2, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(msg2.type == 0x0102);
+        CHECK(msg2.name == "Hello");
+        CHECK(static_cast<const void*>(msg2.name.data()) == &result[6]);
+        CHECK(msg2.payload.data() == &result[15]);
+        CHECK(mozi::equal(msg2.payload, make_byte_span(payload)));
+
+        input = mozi::deserialize_t{result}.first(result.size() - 1);
+        ec = deserialize(msg2, input);
+        CHECK(ec == deserialize_result::input_truncated);
+    }
+
+    SECTION("containers")
+    {
+        Record rec{"Hi",
+                   {0x0102, 0x0304},
+                   {0xAA},
+                   std::nullopt,
+                   7,
+                   {1, 0x0203},
+                   {{"a", 1}, {"b", 2}}};
+        auto result = serialize(rec);
+        std::uint8_t expected_result[]{
+            0x00, 0x00, 0x00, 0x02, 'H',  'i',  0x00, 0x00, 0x00, 0x02,
+            0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x01, 0xAA, 0x00,
+            0x01, 0x07, 0x01, 0x02, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00,
+            0x00, 0x00, 0x01, 'a',  0x01, 0x00, 0x00, 0x00, 0x01, 'b',
+            0x02};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::deserialize_t input{result};
+        Record rec2{"Old", {1, 2, 3}, {}, 5, std::nullopt, {}, {}};
+        auto ec = deserialize(rec2, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(rec2.name == rec.name);
+        CHECK(rec2.values == rec.values);
+        CHECK(rec2.data == rec.data);
+        CHECK(rec2.level == rec.level);
+        CHECK(rec2.weight == rec.weight);
+        CHECK(rec2.ids == rec.ids);
+        CHECK(rec2.index == rec.index);
+
+        // A bogus size prefix must not cause a huge allocation
+        std::uint8_t bad_input[]{0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x01};
+        input = make_byte_span(bad_input);
+        std::vector<std::uint16_t> values;
+        ec = deserialize(values, input);
+        CHECK(ec == deserialize_result::input_truncated);
+        CHECK(input.size() == sizeof bad_input);
+        std::vector<std::string> names;
+        ec = deserialize(names, input);
+        CHECK(ec == deserialize_result::input_truncated);
+        CHECK(names.capacity() <= sizeof bad_input);
+
+        std::tuple<bool, std::uint16_t> tup;
+        std::uint8_t tuple_input[]{0x01, 0x12, 0x34};
+        input = make_byte_span(tuple_input);
+        ec = deserialize(tup, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(tup == std::tuple(true, std::uint16_t{0x1234}));
+        static_assert(
+            mozi::net_pack::serialized_size<decltype(tup)>() == 3);
+
+        // Repeated map keys are invalid
+        std::uint8_t map_input[]{0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+                                 0x00, 0x01, 'a',  0x01, 0x00, 0x00,
+                                 0x00, 0x01, 'a',  0x02};
+        input = make_byte_span(map_input);
+        name_map index;
+        ec = deserialize(index, input);
+        CHECK(ec == deserialize_result::invalid_value);
+        CHECK(input.size() == sizeof map_input);
+        map_input[14] = 'b';
+        ec = deserialize(index, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(index == name_map{{"a", 1}, {"b", 2}});
+
+        // Multimaps keep repeated keys
+        std::multimap<std::string, std::uint8_t> multi{
+            {"a", 1}, {"a", 2}, {"b", 3}};
+        result = serialize(multi);
+        input = mozi::deserialize_t{result};
+        std::multimap<std::string, std::uint8_t> multi2;
+        ec = deserialize(multi2, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(multi2 == multi);
+
+        // Vectors of zero-size elements are rejected at compile time
+        static_assert(
+            mozi::net_pack::serialized_size<std::tuple<>>() == 0);
+        static_assert(!mozi::is_type_complete_v<mozi::net_pack::serializer<
+                          std::vector<std::tuple<>>>>);
+        static_assert(!mozi::is_type_complete_v<mozi::net_pack::serializer<
+                          std::vector<std::array<int, 0>>>>);
+        static_assert(mozi::is_type_complete_v<mozi::net_pack::serializer<
+                          std::vector<std::array<int, 1>>>>);
+    }
+
+    SECTION("integer arrays")
+    {
+        std::int16_t arr1[]{0x0102, -2};
+        std::array<std::uint64_t, 1> arr2{0x0102030405060708};
+        const char arr3[]{'a', 'b'};
+        mozi::serialize_t result;
+        serialize(arr1, result);
+        serialize(arr2, result);
+        serialize(arr3, result);
+        std::uint8_t expected_result[]{0x01, 0x02, 0xFF, 0xFE, 0x01,
+                                       0x02, 0x03, 0x04, 0x05, 0x06,
+                                       0x07, 0x08, 'a',  'b'};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        std::int16_t arr4[2]{};
+        std::array<std::uint64_t, 1> arr5{};
+        char arr6[2]{};
+        mozi::deserialize_t input{result};
+        REQUIRE(deserialize(arr4, input) == deserialize_result::success);
+        REQUIRE(deserialize(arr5, input) == deserialize_result::success);
+        REQUIRE(deserialize(arr6, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(mozi::equal(arr1, arr4));
+        CHECK(arr2 == arr5);
+        CHECK(mozi::equal(arr3, arr6));
+
+        // Larger than a conversion chunk
+        std::array<std::uint32_t, 100> arr7{};
+        for (std::size_t i = 0; i < arr7.size(); ++i) {
+            arr7[i] = static_cast<std::uint32_t>(i * 0x01010101);
+        }
+        result = serialize(arr7);
+        REQUIRE(result.size() == 400);
+        CHECK(result[396] == std::byte{99});
+        CHECK(result[399] == std::byte{99});
+        std::array<std::uint32_t, 100> arr8{};
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(arr8, input) == deserialize_result::success);
+        CHECK(arr7 == arr8);
+
+        std::vector<std::uint32_t> values(arr7.begin(), arr7.end());
+        result = serialize(values);
+        REQUIRE(result.size() == 404);
+        CHECK(result[403] == std::byte{99});
+        std::vector<std::uint32_t> values2;
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(values2, input) == deserialize_result::success);
+        CHECK(values == values2);
+    }
+
+    SECTION("bad input")
+    {
+        S1 data{1, 2, {'H', 'e', 'l', 'l', 'o'}, true};
+        auto result = serialize(data);
+        S1 data2{};
+
+        mozi::deserialize_t input{result};
+        input = input.first(input.size() - 1);
+        auto ec = deserialize(data2, input);
+        CHECK(ec == deserialize_result::input_truncated);
+        CHECK(input.size() == result.size() - 1);
+
+        result.back() = std::byte{2};
+        input = mozi::deserialize_t{result};
+        ec = deserialize(data2, input);
+        CHECK(ec == deserialize_result::invalid_value);
+
+        result.back() = std::byte{1};
+        input = mozi::deserialize_t{result};
+        ec = deserialize(data2, input);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(mozi::equal(data, data2));
+    }
+
+    SECTION("enum validation")
+    {
+        mozi::serialize_t result{std::byte{0}, std::byte{3}};
+        mozi::deserialize_t input{result};
+        RawMode raw_mode{};
+        REQUIRE(deserialize(raw_mode, input) ==
+                deserialize_result::success);
+        CHECK(raw_mode == RawMode{3});
+
+        Mode mode = Mode::run;
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(mode, input) ==
+              deserialize_result::invalid_value);
+        CHECK(mode == Mode::run);
+        CHECK(input.size() == result.size());
+        result[1] = std::byte{5};
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(mode, input) == deserialize_result::success);
+        CHECK(mode == Mode::halt);
+
+        Command command{Mode::idle, Access::read | Access::write};
+        result = serialize(command);
+        CHECK(result == mozi::serialize_t{std::byte{0}, std::byte{1},
+                                          std::byte{3}});
+        Command command2{};
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(command2, input) ==
+                deserialize_result::success);
+        CHECK(mozi::equal(command, command2));
+        result[2] = std::byte{4};
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(command2, input) ==
+              deserialize_result::invalid_value);
+        result[2] = std::byte{2};
+        result[1] = std::byte{0};
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(command2, input) ==
+              deserialize_result::invalid_value);
+
+        // Values covering the whole 64-bit range
+        Handle handle{};
+        result = serialize(Handle::invalid);
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(handle, input) == deserialize_result::success);
+        CHECK(handle == Handle::invalid);
+        result.back() = std::byte{0xFE};
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(handle, input) ==
+              deserialize_result::invalid_value);
+        CHECK(handle == Handle::invalid);
+        CHECK(input.size() == result.size());
+    }
+}
+
+TEST_CASE("serialization: compact_pack")
+{
+    using mozi::compact_pack::serialize;
+    using mozi::compact_pack::deserialize;
+
+    SECTION("integers")
+    {
+        mozi::serialize_t result;
+        serialize(std::uint32_t{300}, result);
+        serialize(std::int16_t{-1}, result);
+        serialize(std::int32_t{1}, result);
+        serialize(std::int64_t{-65}, result);
+        std::uint8_t expected_result[]{0xAC, 0x02, 0x01, 0x02, 0x81, 0x01};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        // Decoding goes through both the fast path and the slow path
+        const std::uint64_t values[]{0,
+                                     1,
+                                     127,
+                                     128,
+                                     0x3FFF,
+                                     0x4000,
+                                     0xFFFFFFFF,
+                                     0x00FFFFFFFFFFFFFF,
+                                     0x0100000000000000,
+                                     UINT64_MAX};
+        result.clear();
+        for (auto value : values) {
+            serialize(value, result);
+            serialize(static_cast<std::int64_t>(value), result);
+        }
+        mozi::deserialize_t input{result};
+        for (auto value : values) {
+            std::uint64_t value1{};
+            std::int64_t value2{};
+            REQUIRE(deserialize(value1, input) ==
+                    deserialize_result::success);
+            REQUIRE(deserialize(value2, input) ==
+                    deserialize_result::success);
+            CHECK(value1 == value);
+            CHECK(value2 == static_cast<std::int64_t>(value));
+        }
+        CHECK(input.empty());
+    }
+
+    SECTION("bad input")
+    {
+        std::uint16_t value{};
+        std::uint8_t too_large[]{0xFF, 0xFF, 0x04};
+        mozi::deserialize_t input{make_byte_span(too_large)};
+        CHECK(deserialize(value, input) ==
+              deserialize_result::invalid_value);
+
+        std::uint8_t too_long[]{0x80, 0x80, 0x80, 0x00, 0, 0, 0, 0};
+        input = make_byte_span(too_long);
+        CHECK(deserialize(value, input) ==
+              deserialize_result::invalid_value);
+        input = input.first(4);
+        CHECK(deserialize(value, input) ==
+              deserialize_result::invalid_value);
+
+        std::uint8_t non_minimal[]{0x81, 0x00, 0, 0, 0, 0, 0, 0};
+        input = make_byte_span(non_minimal);
+        CHECK(deserialize(value, input) ==
+              deserialize_result::invalid_value);
+        CHECK(input.size() == 8);
+        input = input.first(2);
+        CHECK(deserialize(value, input) ==
+              deserialize_result::invalid_value);
+        CHECK(input.size() == 2);
+
+        std::uint8_t zero[]{0x00};
+        input = make_byte_span(zero);
+        value = 1;
+        CHECK(deserialize(value, input) == deserialize_result::success);
+        CHECK(value == 0);
+        CHECK(input.empty());
+
+        std::uint8_t truncated[]{0x80};
+        input = make_byte_span(truncated);
+        CHECK(deserialize(value, input) ==
+              deserialize_result::input_truncated);
+        CHECK(input.size() == 1);
+    }
+
+    SECTION("bools")
+    {
+        bool flags[10]{true, false, true};
+        flags[9] = true;
+        auto result = serialize(flags);
+        std::uint8_t expected_result[]{0x05, 0x02};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        bool flags2[10]{};
+        mozi::deserialize_t input{result};
+        REQUIRE(deserialize(flags2, input) == deserialize_result::success);
+        CHECK(mozi::equal(flags, flags2));
+
+        result[1] = std::byte{0x06};
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(flags2, input) ==
+              deserialize_result::invalid_value);
+    }
+
+    SECTION("structs")
+    {
+        S1 data{1, 2, {'H', 'e', 'l', 'l', 'o'}, true};
+        auto result = serialize(data);
+        std::uint8_t expected_result[]{0x01, 0x02, 0x04, 'H', 'e', 'l',
+                                       'l',  'o',  0,    0,   0};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::deserialize_t input{result};
+        S1 data2{};
+        REQUIRE(deserialize(data2, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(mozi::equal(data, data2));
+    }
+
+    SECTION("fallback")
+    {
+        // Bit-fields containers are handled by net_pack, and their
+        // packed values by compact_pack
+        mozi::serializer_list<mozi::compact_pack::serializer,
+                              mozi::net_pack::serializer>
+            serializers;
+        S2 data{42, {{4}, {5}}, {{31}, {0}}, {{1}, {0}, {0}}};
+        mozi::serialize_t result;
+        mozi::serialize(data, result, serializers);
+        std::uint8_t expected_result[]{0x54, 0x45, 0x80, 0xf0, 0x03,
+                                       0x80, 0x80, 0x80, 0x80, 0x02};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::deserialize_t input{result};
+        S2 data2{};
+        auto ec = mozi::deserialize(data2, input, serializers);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(mozi::equal(data, data2));
+    }
+}
+
+TEST_CASE("serialization: host_pack")
+{
+    using mozi::host_pack::serialize;
+    using mozi::host_pack::deserialize;
+
+    SECTION("bitwise copy")
+    {
+        static_assert(mozi::host_pack::is_bitwise_serializable_v<Point>);
+        static_assert(!mozi::host_pack::is_bitwise_serializable_v<S1>);
+        static_assert(!mozi::host_pack::is_bitwise_serializable_v<S3>);
+
+        Point data{1, -2, {3, 4}};
+        auto result = serialize(data);
+        REQUIRE(result.size() == sizeof(Point));
+        CHECK(std::memcmp(result.data(), &data, sizeof(Point)) == 0);
+
+        mozi::deserialize_t input{result};
+        Point data2{};
+        REQUIRE(deserialize(data2, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(mozi::equal(data, data2));
+
+        input = mozi::deserialize_t{result}.first(result.size() - 1);
+        CHECK(deserialize(data2, input) ==
+              deserialize_result::input_truncated);
+    }
+
+    SECTION("field by field")
+    {
+        S3 data{1, 2, {'H', 'e', 'l', 'l', 'o'}, 1.5, true};
+        auto result = serialize(data);
+        CHECK(result.size() == 19);
+        mozi::deserialize_t input{result};
+        S3 data2{};
+        REQUIRE(deserialize(data2, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(mozi::equal(data, data2));
+
+        result.back() = std::byte{2};
+        input = mozi::deserialize_t{result};
+        CHECK(deserialize(data2, input) ==
+              deserialize_result::invalid_value);
+    }
+
+    SECTION("fallback")
+    {
+        // Bit-fields containers are handled by net_pack, and their
+        // packed values by host_pack
+        mozi::serializer_list<mozi::host_pack::serializer,
+                              mozi::net_pack::serializer>
+            serializers;
+        S2 data{42, {{4}, {5}}, {{31}, {0}}, {{1}, {0}, {0}}};
+        mozi::serialize_t result;
+        mozi::serialize(data, result, serializers);
+        CHECK(result.size() == 9);
+
+        mozi::deserialize_t input{result};
+        S2 data2{};
+        auto ec = mozi::deserialize(data2, input, serializers);
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(mozi::equal(data, data2));
+    }
+}
+
+TEST_CASE("serialization: bit_pack")
+{
+    using mozi::bit_pack::serialize;
+    using mozi::bit_pack::deserialize;
+
+    SECTION("structs")
+    {
+        Frame frame{true, {{5}, {-1}}, 0xABCD, {{{{1}, {1}}, {{7}, {-2}}}}};
+        auto result = serialize(frame);
+        std::uint8_t expected_result[]{0xde, 0xaf, 0x34, 0xbe};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::deserialize_t input{result};
+        Frame frame2{};
+        REQUIRE(deserialize(frame2, input) == deserialize_result::success);
+        CHECK(input.empty());
+        CHECK(frame2.valid);
+        CHECK(frame2.tag.kind == 5);
+        CHECK(frame2.tag.delta == -1);
+        CHECK(frame2.id == 0xABCD);
+        CHECK(frame2.more[1].kind == 7);
+        CHECK(frame2.more[1].delta == -2);
+
+        input = mozi::deserialize_t{result}.first(3);
+        CHECK(deserialize(frame2, input) ==
+              deserialize_result::input_truncated);
+    }
+
+    SECTION("stream")
+    {
+        mozi::serialize_t result;
+        mozi::bit_pack::bit_writer writer(result);
+        for (unsigned i = 0; i < 3; ++i) {
+            serialize(Tag{{i + 1}, {1}}, writer);
+        }
+        writer.flush();
+        REQUIRE(result.size() == 2);
+        CHECK(result[0] == std::byte{0b00101010});
+        CHECK(result[1] == std::byte{0b01011010});
+
+        mozi::bit_pack::bit_reader reader{mozi::deserialize_t{result}};
+        for (unsigned i = 0; i < 3; ++i) {
+            Tag tag{};
+            REQUIRE(deserialize(tag, reader) ==
+                    deserialize_result::success);
+            CHECK(tag.kind == i + 1);
+            CHECK(tag.delta == 1);
+        }
+        CHECK(reader.is_padding_zero());
+        CHECK(reader.remaining().empty());
+    }
+
+    SECTION("across words")
+    {
+        std::tuple<bool, std::uint64_t, std::int8_t> values{
+            true, 0x0123456789ABCDEF, -2};
+        mozi::serialize_t result;
+        mozi::bit_pack::bit_writer writer(result);
+        serialize(std::get<0>(values), writer);
+        serialize(std::get<1>(values), writer);
+        serialize(std::get<2>(values), writer);
+        writer.flush();
+        std::uint8_t expected_result[]{0x80, 0x91, 0xa2, 0xb3, 0xc4,
+                                       0xd5, 0xe6, 0xf7, 0xff, 0x00};
+        CHECK(mozi::equal(mozi::span<const std::byte>(result),
+                          make_byte_span(expected_result)));
+
+        mozi::bit_pack::bit_reader reader{mozi::deserialize_t{result}};
+        bool v1{};
+        std::uint64_t v2{};
+        std::int8_t v3{};
+        REQUIRE(deserialize(v1, reader) == deserialize_result::success);
+        REQUIRE(deserialize(v2, reader) == deserialize_result::success);
+        REQUIRE(deserialize(v3, reader) == deserialize_result::success);
+        CHECK(std::tuple(v1, v2, v3) == values);
+        CHECK(deserialize(v1, reader) == deserialize_result::success);
+        CHECK(reader.remaining().empty());
+    }
+
+    SECTION("packed containers")
+    {
+        Wide96 wide{};
+        wide.a() = 0xFEDCBA9876;
+        wide.b() = 0x0123456789;
+        wide.c() = 0xABCD;
+        mozi::serialize_t result;
+        mozi::bit_pack::bit_writer writer(result);
+        serialize(Tag{{7}, {0}}, writer);
+        serialize(wide, writer);
+        writer.flush();
+        REQUIRE(result.size() == 13);
+        CHECK(result[0] == std::byte{0xe7});
+        CHECK(result[12] == std::byte{0x68});
+
+        mozi::bit_pack::bit_reader reader{mozi::deserialize_t{result}};
+        Tag tag{};
+        Wide96 wide2{};
+        REQUIRE(deserialize(tag, reader) == deserialize_result::success);
+        REQUIRE(deserialize(wide2, reader) == deserialize_result::success);
+        CHECK(tag.kind == 7);
+        CHECK(wide2 == wide);
+    }
+
+    SECTION("bad input")
+    {
+        mozi::serialize_t result{std::byte{0b00101011}};
+        mozi::deserialize_t input{result};
+        Tag tag{};
+        CHECK(deserialize(tag, input) ==
+              deserialize_result::unexpected_input_data);
+        result[0] = std::byte{0b00101000};
+        input = mozi::deserialize_t{result};
+        REQUIRE(deserialize(tag, input) == deserialize_result::success);
+        CHECK(tag.kind == 1);
+        CHECK(tag.delta == 1);
+    }
+}
+
+TEST_CASE("serialization: net_pack serialized size")
+{
+    using mozi::net_pack::has_fixed_size_v;
+    using mozi::net_pack::serialized_size;
+
+    static_assert(serialized_size<bool>() == 1);
+    static_assert(serialized_size<std::uint32_t>() == 4);
+    static_assert(serialized_size<std::byte>() == 1);
+    static_assert(serialized_size<const char_array_8>() == 8);
+    static_assert(serialized_size<std::array<std::uint16_t, 3>>() == 6);
+    static_assert(serialized_size<Flags32>() == 4);
+    static_assert(serialized_size<S1>() == 15);
+    static_assert(serialized_size<S2>() == 9);
+    static_assert(!has_fixed_size_v<float>);
+    static_assert(!has_fixed_size_v<S3>);
+
+    S2 data{42,
+            {{4}, {5}},
+            {{31}, {0}},
+            {{1}, {0x1FFFF}, {0b101010101010}}};
+    auto result = mozi::net_pack::serialize(data);
+    CHECK(result.size() == serialized_size<S2>());
+}
+
+TEST_CASE("serialization: sinks")
+{
+    S1 data{1, 2, {'H', 'e', 'l', 'l', 'o'}, true};
+    auto expected = mozi::net_pack::serialize(data);
+
+    SECTION("std::string")
+    {
+        std::string result;
+        mozi::net_pack::serialize(data, result);
+        CHECK(mozi::equal(mozi::span<const std::byte>(expected),
+                          make_byte_span(result.data(), result.size())));
+    }
+
+    SECTION("caller-owned buffer")
+    {
+        std::byte buffer[20];
+        mozi::buffer_sink sink{buffer};
+        mozi::net_pack::serialize(data, sink);
+        CHECK_FALSE(sink.overflowed());
+        CHECK(sink.size() == expected.size());
+        CHECK(mozi::equal(mozi::span<const std::byte>(expected),
+                          sink.written()));
+
+        mozi::net_pack::serialize(data, sink);
+        CHECK(sink.overflowed());
+        CHECK(sink.size() < expected.size() * 2);
+
+        sink.clear();
+        mozi::serializer_list<mozi::net_pack::serializer> serializers;
+        auto ec = mozi::serialize(data, sink, serializers);
+        CHECK(ec == mozi::serialize_result::success);
+        CHECK(sink.size() == expected.size());
+    }
+
+    SECTION("static buffer")
+    {
+        mozi::static_serialize_buffer<
+            mozi::net_pack::serialized_size<S1>()>
+            buffer;
+        auto ec = mozi::net_pack::serialize(data, buffer);
+        CHECK(ec == mozi::serialize_result::success);
+        CHECK(mozi::equal(mozi::span<const std::byte>(expected),
+                          buffer.written()));
+
+        ec = mozi::net_pack::serialize(true, buffer);
+        CHECK(ec == mozi::serialize_result::output_overflow);
+        CHECK(buffer.size() == expected.size());
+
+        buffer.clear();
+        ec = mozi::net_pack::serialize(true, buffer);
+        CHECK(ec == mozi::serialize_result::success);
+        CHECK(buffer.size() == 1);
+    }
+}
+
+TEST_CASE("serialization: stream deserializer")
+{
+    S2 data[3]{{1, {{4}, {5}}, {{31}, {0}}, {{1}, {2}, {3}}},
+               {2, {{1}, {2}}, {{3}, {4}}, {{5}, {6}, {7}}},
+               {3, {{7}, {6}}, {{5}, {4}}, {{3}, {2}, {1}}}};
+    auto result = mozi::net_pack::serialize(data);
+    result.push_back(std::byte{0x42});
+    using serializers = mozi::serializer_list<mozi::net_pack::serializer>;
+    static_assert(mozi::stream_deserializer<S2[3], serializers>::
+                      total_steps == 12);
+
+    // Views would point into the internal buffer
+    static_assert(
+        !mozi::detail::contains_borrowed_value<S2[3], serializers>());
+    static_assert(
+        !mozi::detail::contains_borrowed_value<Record, serializers>());
+    static_assert(mozi::detail::contains_borrowed_value<std::string_view,
+                                                        serializers>());
+    static_assert(
+        mozi::detail::contains_borrowed_value<Message[2], serializers>());
+    static_assert(mozi::detail::contains_borrowed_value<
+                  std::vector<mozi::span<const std::byte>>, serializers>());
+    static_assert(mozi::detail::contains_borrowed_value<
+                  std::map<int, std::optional<std::string_view>>,
+                  serializers>());
+    static_assert(mozi::detail::contains_borrowed_value<
+                  std::tuple<int, std::string_view[2]>, serializers>());
+
+    for (int n : {1, 2, 3, 5, 8, 13, 100}) {
+        auto chunk_size = static_cast<std::size_t>(n);
+        S2 data2[3]{};
+        mozi::stream_deserializer decoder(data2, serializers{});
+        mozi::deserialize_t input{result};
+        auto ec = deserialize_result::input_truncated;
+        while (!input.empty() && !decoder.done()) {
+            auto chunk = input.first(std::min(chunk_size, input.size()));
+            input = input.subspan(chunk.size());
+            ec = decoder.feed(chunk);
+            if (!decoder.done()) {
+                CHECK(ec == deserialize_result::input_truncated);
+                CHECK(chunk.empty());
+            } else {
+                CHECK(ec == deserialize_result::success);
+                input = mozi::deserialize_t(chunk.data(),
+                                            chunk.size() + input.size());
+            }
+        }
+        REQUIRE(ec == deserialize_result::success);
+        CHECK(decoder.steps_done() == 12);
+        CHECK(decoder.bytes_consumed() == result.size() - 1);
+        CHECK(input.size() == 1);
+        CHECK(mozi::equal(data, data2));
     }
+
+    S1 value{};
+    mozi::stream_deserializer decoder(value, serializers{});
+    std::uint8_t bad_input[]{0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 'H', 'e',
+                             'l',  'l',  'o',  0,    0,    0,    0x02};
+    auto input = make_byte_span(bad_input);
+    auto chunk = input.first(5);
+    CHECK(decoder.feed(chunk) == deserialize_result::input_truncated);
+    CHECK(decoder.steps_done() == 1);
+    chunk = input.subspan(5);
+    CHECK(decoder.feed(chunk) == deserialize_result::invalid_value);
+    CHECK(decoder.steps_done() == 10);
+    CHECK(chunk.size() == 1);
+    CHECK(value.v1 == 1);
+    CHECK(value.v2 == 2);
+}
+
+TEST_CASE("serialization: stream deserializer containers")
+{
+    using serializers = mozi::serializer_list<mozi::net_pack::serializer>;
+    Record rec{std::string(5000, 'x'), {}, {}, 1, std::nullopt, {}, {}};
+    for (std::size_t i = 0; i < 3000; ++i) {
+        rec.values.push_back(static_cast<std::uint16_t>(i * 7));
+        rec.data.push_back(static_cast<std::uint8_t>(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        rec.index.emplace(std::to_string(i),
+                          static_cast<std::uint8_t>(i));
+    }
+    auto result = mozi::net_pack::serialize(rec);
+
+    Record rec2{"Old", {1, 2, 3}, {}, 5, 6, {}, {}};
+    mozi::stream_deserializer decoder(rec2, serializers{});
+    static_assert(decltype(decoder)::total_steps == 7);
+    mozi::deserialize_t input{result};
+    auto ec = deserialize_result::input_truncated;
+    while (!input.empty()) {
+        auto chunk = input.first(std::min(std::size_t{3}, input.size()));
+        input = input.subspan(chunk.size());
+        ec = decoder.feed(chunk);
+        CHECK(chunk.empty());
+        if (decoder.bytes_consumed() == 2502) {
+            // Resumed inside the string, not restarted
+            CHECK(decoder.steps_done() == 0);
+            CHECK(rec2.name.size() == 2498);
+        }
+    }
+    REQUIRE(ec == deserialize_result::success);
+    CHECK(decoder.done());
+    CHECK(decoder.bytes_consumed() == result.size());
+    CHECK(rec2.name == rec.name);
+    CHECK(rec2.values == rec.values);
+    CHECK(rec2.data == rec.data);
+    CHECK(rec2.level == rec.level);
+    CHECK(rec2.weight == rec.weight);
+    CHECK(rec2.index == rec.index);
 }
 
 TEST_CASE("serialization: multiple serializers")